@@ -0,0 +1,453 @@
+#ifndef BIGDECIMAL_HPP
+#define BIGDECIMAL_HPP
+
+#include "bigint.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Exact decimal number stored as an unscaled bigint and a scale, with the value unscaled / 10^scale.
+ * Since bigint stores decimal digits, changing the scale only inserts or drops digits and never multiplies or divides.
+ * Addition, subtraction and multiplication are exact. Division and lowering the scale round with a given mode.
+ */
+class bigdecimal
+{
+public:
+    /**
+     * @brief How the digits dropped by division or rescaling round the result
+     */
+    enum class rounding_mode : std::uint8_t
+    {
+        down,      // Toward zero
+        up,        // Away from zero
+        half_up,   // To nearest, ties away from zero
+        half_down, // To nearest, ties toward zero
+        half_even, // To nearest, ties to an even last digit
+        floor,     // Toward negative infinity
+        ceiling,   // Toward positive infinity
+    };
+
+private:
+    bigint unscaled;
+    std::size_t fraction_digits = 0;
+
+    /**
+     * @brief Decide if a truncated magnitude has to be rounded away from zero
+     * @param mode Rounding mode
+     * @param negative Sign of the exact result
+     * @param odd True iff the last kept digit is odd
+     * @param half Sign of (dropped part - one half of the last kept digit), -1, 0 or 1
+     * @return True iff the magnitude has to be increased by one
+     */
+    static constexpr bool round_away(rounding_mode mode, bool negative, bool odd, int half)
+    {
+        switch (mode)
+        {
+        case rounding_mode::down:
+            return false;
+        case rounding_mode::up:
+            return true;
+        case rounding_mode::half_up:
+            return half >= 0;
+        case rounding_mode::half_down:
+            return half > 0;
+        case rounding_mode::half_even:
+            return half > 0 || (half == 0 && odd);
+        case rounding_mode::floor:
+            return negative;
+        case rounding_mode::ceiling:
+            return !negative;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Add one to the magnitude of a truncated result if the rounding mode asks for it
+     * @param value The truncated result, its sign is restored if it was truncated to zero
+     * @param negative Sign of the exact result
+     * @param half Sign of (dropped part - one half of the last kept digit)
+     * @param mode Rounding mode
+     */
+    static constexpr void round_truncated(bigint &value, bool negative, int half, rounding_mode mode)
+    {
+        if (round_away(mode, negative, (value.digits[0] & 1) != 0, half))
+        {
+            bigint::add_one_in_place(value.digits);
+            value.isNegative = negative;
+        }
+    }
+
+    /**
+     * @brief Divide a number by 10^<n> and round it, looking only at the dropped digits
+     * @param value The number, replaced by the rounded quotient
+     * @param n Power of ten
+     * @param mode Rounding mode
+     */
+    static constexpr void round_pow10(bigint &value, std::size_t n, rounding_mode mode)
+    {
+        if (n == 0)
+            return;
+
+        // The first dropped digit decides the comparison with one half unless it is 5
+        const std::vector<std::uint8_t> &digits = value.digits;
+        const std::uint8_t first = n <= digits.size() ? digits[n - 1] : 0;
+        bool rest_zero = true;
+        for (std::size_t i = 0; i < std::min(n - 1, digits.size()) && rest_zero; i++)
+            rest_zero = digits[i] == 0;
+        if (first == 0 && rest_zero)
+        {
+            value.divide_pow10(n); // Exact
+            return;
+        }
+
+        const int half = first > 5 ? 1 : (first < 5 ? -1 : (rest_zero ? 0 : 1));
+        const bool negative = value.isNegative;
+        value.divide_pow10(n);
+        round_truncated(value, negative, half, mode);
+    }
+
+    /**
+     * @brief Compare two numbers after bringing them to the same scale
+     * @param lhs The first number
+     * @param rhs The second number
+     * @return -1, 0 or 1 as lhs is less than, equal to or greater than rhs
+     */
+    static int compare(const bigdecimal &lhs, const bigdecimal &rhs)
+    {
+        if (lhs.fraction_digits == rhs.fraction_digits)
+            return lhs.unscaled < rhs.unscaled ? -1 : (lhs.unscaled == rhs.unscaled ? 0 : 1);
+        if (lhs.fraction_digits < rhs.fraction_digits)
+            return -compare(rhs, lhs);
+
+        bigint aligned = rhs.unscaled;
+        aligned.multiply_pow10(lhs.fraction_digits - rhs.fraction_digits);
+        return lhs.unscaled < aligned ? -1 : (lhs.unscaled == aligned ? 0 : 1);
+    }
+
+public:
+    /**
+     * @brief Default constructor: Initialize the number to 0 with scale 0
+     */
+    bigdecimal() = default;
+
+    /**
+     * @brief Unscaled constructor: Initialize the number to unscaled / 10^scale
+     * @param unscaled The digits of the number without the decimal point
+     * @param scale Number of digits after the decimal point
+     */
+    explicit bigdecimal(bigint unscaled, std::size_t scale = 0) : unscaled(std::move(unscaled)), fraction_digits(scale)
+    {
+    }
+
+    /**
+     * @brief String constructor: Parse a decimal string like "-1234.5678". The scale is the number of digits after the
+     * point, so "1.50" has scale 2. Throws an invalid_argument exception if the string is not a decimal number.
+     * @param str An optional sign, digits, and optionally a point followed by more digits
+     */
+    explicit bigdecimal(std::string_view str)
+    {
+        std::size_t start = 0;
+        if (!str.empty() && (str[0] == '-' || str[0] == '+'))
+            start = 1;
+
+        const std::size_t point = str.find('.', start);
+        const std::size_t digit_count = str.size() - start - (point == std::string_view::npos ? 0 : 1);
+        if (digit_count == 0)
+            throw std::invalid_argument("Error: String contains no digits.");
+
+        // Collect the digits least significant first, skipping the point
+        std::vector<std::uint8_t> digits = bigint::scratch_pool::acquire(digit_count);
+        std::size_t k = 0;
+        for (std::size_t i = str.size(); i > start; i--)
+        {
+            if (i - 1 == point)
+                continue;
+            if (str[i - 1] < '0' || str[i - 1] > '9')
+            {
+                bigint::scratch_pool::release(std::move(digits));
+                throw std::invalid_argument("Error: String contains non-digit char.");
+            }
+            digits[k++] = static_cast<std::uint8_t>(str[i - 1] - '0');
+        }
+
+        bigint::remove_leading_zeros(digits);
+        this->unscaled.replace_digits(std::move(digits));
+        this->unscaled.isNegative = str[0] == '-' && !bigint::is_abs_zero(this->unscaled.digits);
+        this->fraction_digits = point == std::string_view::npos ? 0 : str.size() - point - 1;
+    }
+
+    /**
+     * @brief The digits of the number without the decimal point
+     * @return The unscaled value
+     */
+    const bigint &unscaled_value() const
+    {
+        return this->unscaled;
+    }
+
+    /**
+     * @brief Number of digits after the decimal point
+     * @return The scale
+     */
+    std::size_t scale() const
+    {
+        return this->fraction_digits;
+    }
+
+    /**
+     * @brief The same number with another scale. Raising the scale appends zeros, lowering it drops digits and rounds.
+     * @param scale The new scale
+     * @param mode Rounding mode used if digits are dropped
+     * @return The number with the new scale
+     */
+    bigdecimal rescale(std::size_t scale, rounding_mode mode = rounding_mode::half_even) const
+    {
+        bigdecimal result = *this;
+        if (scale > this->fraction_digits)
+            result.unscaled.multiply_pow10(scale - this->fraction_digits);
+        else
+            round_pow10(result.unscaled, this->fraction_digits - scale, mode);
+        result.fraction_digits = scale;
+        return result;
+    }
+
+    /**
+     * @brief Divide by another number and round the quotient to a given scale.
+     * The dividend is shifted so one long division gives the quotient at that scale, and the remainder decides the
+     * rounding.
+     * @param rhs The divisor
+     * @param scale Scale of the quotient
+     * @param mode Rounding mode
+     * @return The rounded quotient
+     */
+    bigdecimal divide(const bigdecimal &rhs, std::size_t scale, rounding_mode mode = rounding_mode::half_even) const
+    {
+        if (bigint::is_abs_zero(rhs.unscaled.digits))
+            throw std::logic_error("Error: Division by zero");
+
+        // (a / 10^sa) / (b / 10^sb) = (a * 10^(scale + sb - sa) / b) / 10^scale
+        bigint dividend = this->unscaled;
+        bigint divisor = rhs.unscaled;
+        dividend.isNegative = false;
+        divisor.isNegative = false;
+        if (scale + rhs.fraction_digits >= this->fraction_digits)
+            dividend.multiply_pow10(scale + rhs.fraction_digits - this->fraction_digits);
+        else
+            divisor.multiply_pow10(this->fraction_digits - scale - rhs.fraction_digits);
+
+        std::vector<std::uint8_t> quotient;
+        std::vector<std::uint8_t> remainder;
+        bigint::divmod_abs(dividend.digits, divisor.digits, quotient, remainder);
+
+        bigdecimal result;
+        result.fraction_digits = scale;
+        result.unscaled.replace_digits(std::move(quotient));
+        const bool negative = this->unscaled.isNegative != rhs.unscaled.isNegative;
+        result.unscaled.isNegative = negative && !bigint::is_abs_zero(result.unscaled.digits);
+
+        if (!bigint::is_abs_zero(remainder))
+        {
+            // Compare twice the remainder with the divisor
+            bigint rest;
+            rest.replace_digits(std::move(remainder));
+            const bigint twice = rest + rest;
+            const int half = twice < divisor ? -1 : (twice == divisor ? 0 : 1);
+            round_truncated(result.unscaled, negative, half, mode);
+        }
+        else
+        {
+            bigint::scratch_pool::release(std::move(remainder));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Convert the number to a string with exactly scale() digits after the point
+     * @return The string, like "-1234.5678" or "0.05"
+     */
+    std::string to_string() const
+    {
+        const std::vector<std::uint8_t> &digits = this->unscaled.digits;
+        const std::size_t integer_digits = digits.size() > this->fraction_digits ? digits.size() - this->fraction_digits : 1;
+
+        std::string str;
+        str.reserve(integer_digits + this->fraction_digits + 2);
+        if (this->unscaled.isNegative)
+            str.push_back('-');
+        for (std::size_t i = integer_digits + this->fraction_digits; i > 0; i--)
+        {
+            if (i == this->fraction_digits)
+                str.push_back('.');
+            str.push_back(static_cast<char>('0' + (i - 1 < digits.size() ? digits[i - 1] : 0)));
+        }
+        return str;
+    }
+
+    /**
+     * @brief Negation Operator: Negate the number
+     * @return A new number with the opposite sign and the same scale
+     */
+    bigdecimal operator-() const
+    {
+        return bigdecimal(-this->unscaled, this->fraction_digits);
+    }
+
+    /**
+     * @brief Addition Assignment Operator: Add another number exactly. The scale becomes the larger of the two.
+     * @param rhs The number to be added
+     * @return The current number after addition
+     */
+    bigdecimal &operator+=(const bigdecimal &rhs)
+    {
+        if (this->fraction_digits < rhs.fraction_digits)
+        {
+            this->unscaled.multiply_pow10(rhs.fraction_digits - this->fraction_digits);
+            this->fraction_digits = rhs.fraction_digits;
+        }
+        else if (this->fraction_digits > rhs.fraction_digits)
+        {
+            bigint aligned = rhs.unscaled;
+            aligned.multiply_pow10(this->fraction_digits - rhs.fraction_digits);
+            this->unscaled += aligned;
+            return *this;
+        }
+        this->unscaled += rhs.unscaled;
+        return *this;
+    }
+
+    /**
+     * @brief Subtraction Assignment Operator: Subtract another number exactly. The scale becomes the larger of the two.
+     * @param rhs The number to be subtracted
+     * @return The current number after subtraction
+     */
+    bigdecimal &operator-=(const bigdecimal &rhs)
+    {
+        return *this += -rhs;
+    }
+
+    /**
+     * @brief Multiplication Assignment Operator: Multiply by another number exactly. The scales add up.
+     * @param rhs The number to be multiplied with
+     * @return The current number after multiplication
+     */
+    bigdecimal &operator*=(const bigdecimal &rhs)
+    {
+        this->unscaled *= rhs.unscaled;
+        this->fraction_digits += rhs.fraction_digits;
+        return *this;
+    }
+
+    /**
+     * @brief Addition Operator: Add two numbers exactly
+     * @param lhs The first number
+     * @param rhs The second number
+     * @return A new number that is the sum, with the larger scale
+     */
+    friend bigdecimal operator+(bigdecimal lhs, const bigdecimal &rhs)
+    {
+        return lhs += rhs;
+    }
+
+    /**
+     * @brief Subtraction Operator: Subtract two numbers exactly
+     * @param lhs The number to be subtracted from
+     * @param rhs The number to be subtracted
+     * @return A new number that is the difference, with the larger scale
+     */
+    friend bigdecimal operator-(bigdecimal lhs, const bigdecimal &rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    /**
+     * @brief Multiplication Operator: Multiply two numbers exactly
+     * @param lhs The first number
+     * @param rhs The second number
+     * @return A new number that is the product, with the sum of the scales
+     */
+    friend bigdecimal operator*(bigdecimal lhs, const bigdecimal &rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    /**
+     * @brief Equality Operator: Check if two numbers have the same value, so 1.5 equals 1.50
+     * @param rhs The number to be compared with
+     * @return True iff the two values are equal
+     */
+    bool operator==(const bigdecimal &rhs) const
+    {
+        return compare(*this, rhs) == 0;
+    }
+
+    /**
+     * @brief Inequality Operator: Check if two numbers have different values
+     * @param rhs The number to be compared with
+     * @return True iff the two values are not equal
+     */
+    bool operator!=(const bigdecimal &rhs) const
+    {
+        return compare(*this, rhs) != 0;
+    }
+
+    /**
+     * @brief Less Than Operator
+     * @param rhs The number to be compared with
+     * @return True iff the current number is less than <rhs>
+     */
+    bool operator<(const bigdecimal &rhs) const
+    {
+        return compare(*this, rhs) < 0;
+    }
+
+    /**
+     * @brief Less Than or Equal To Operator
+     * @param rhs The number to be compared with
+     * @return True iff the current number is less than or equal to <rhs>
+     */
+    bool operator<=(const bigdecimal &rhs) const
+    {
+        return compare(*this, rhs) <= 0;
+    }
+
+    /**
+     * @brief Greater Than Operator
+     * @param rhs The number to be compared with
+     * @return True iff the current number is greater than <rhs>
+     */
+    bool operator>(const bigdecimal &rhs) const
+    {
+        return compare(*this, rhs) > 0;
+    }
+
+    /**
+     * @brief Greater Than or Equal To Operator
+     * @param rhs The number to be compared with
+     * @return True iff the current number is greater than or equal to <rhs>
+     */
+    bool operator>=(const bigdecimal &rhs) const
+    {
+        return compare(*this, rhs) >= 0;
+    }
+
+    /**
+     * @brief Insertion Operator: Send the number to the output stream with exactly scale() digits after the point
+     * @param stream Output stream to send the number
+     * @param num Number to be sent
+     * @return The output stream after sending the number
+     */
+    friend std::ostream &operator<<(std::ostream &stream, const bigdecimal &num)
+    {
+        return stream << num.to_string();
+    }
+};
+
+#endif
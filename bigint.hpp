@@ -1,24 +1,583 @@
 #ifndef BIGINT_HPP
 #define BIGINT_HPP
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <limits>
+#include <random>
 #include <ranges>
 
+#if __has_include(<format>)
+#include <format>
+#endif
+
+// Dispatch thresholds measured on this machine by tune.cpp, if it has been run
+#if __has_include("bigint_tuning.hpp")
+#include "bigint_tuning.hpp"
+#endif
+
+#ifndef BIGINT_KARATSUBA_THRESHOLD
+#define BIGINT_KARATSUBA_THRESHOLD 48 // Digits of the shorter operand from which Karatsuba is used
+#endif
+
+#ifdef BIGINT_ENABLE_INSTRUMENTATION
+#include <atomic>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
+/**
+ * @brief Kernels and algorithm tiers tracked by the instrumentation
+ */
+enum class bigint_kernel : std::uint8_t
+{
+    add,                 // add_abs, add_abs_in_place
+    subtract,            // subtract_abs
+    multiply_schoolbook, // multiply_schoolbook
+    multiply_karatsuba,  // multiply_karatsuba, one call per level
+    divide_schoolbook,   // divmod_abs
+    fused_multiply_add,  // addmul, submul
+    multiply_word,       // multiply_small_add_in_place
+    divide_word,         // divide_small_in_place
+    parse,               // String constructors
+    format,              // operator<< and to_string
+    count,
+};
+
+/**
+ * @brief Counters of one kernel
+ */
+struct bigint_kernel_stats
+{
+    std::uint64_t calls = 0;
+    std::uint64_t ticks = 0;                        // Time spent, including nested kernels. TSC cycles on x86, nanoseconds elsewhere.
+    std::array<std::uint64_t, 65> size_histogram{}; // Bucket k counts calls whose largest operand has 2^(k-1) to 2^k - 1 digits
+};
+
+/**
+ * @brief Snapshot of all counters of the instrumentation
+ */
+struct bigint_stats
+{
+    std::array<bigint_kernel_stats, static_cast<std::size_t>(bigint_kernel::count)> kernels{};
+    std::uint64_t allocations = 0;     // Buffers the scratch pool had to allocate
+    std::uint64_t bytes_allocated = 0; // Capacity of those buffers
+    std::uint64_t pool_hits = 0;       // Buffers served by the scratch pool without allocating
+
+    /**
+     * @brief Name of a kernel as used in the JSON dump
+     * @param kernel The kernel
+     * @return The name
+     */
+    static const char *kernel_name(bigint_kernel kernel)
+    {
+        constexpr std::array<const char *, static_cast<std::size_t>(bigint_kernel::count)> names{
+            "add", "subtract", "multiply_schoolbook", "multiply_karatsuba", "divide_schoolbook", "fused_multiply_add",
+            "multiply_word", "divide_word", "parse", "format"};
+        return names[static_cast<std::size_t>(kernel)];
+    }
+
+    /**
+     * @brief Dump the counters as a JSON object. Histograms end at their last non-empty bucket.
+     * @return The JSON text
+     */
+    std::string to_json() const
+    {
+        std::string json = "{\"allocations\":" + std::to_string(this->allocations) +
+                           ",\"bytes_allocated\":" + std::to_string(this->bytes_allocated) +
+                           ",\"pool_hits\":" + std::to_string(this->pool_hits) + ",\"kernels\":{";
+        for (std::size_t i = 0; i < this->kernels.size(); i++)
+        {
+            const bigint_kernel_stats &stats = this->kernels[i];
+            json += (i == 0 ? "\"" : ",\"") + std::string(kernel_name(static_cast<bigint_kernel>(i))) +
+                    "\":{\"calls\":" + std::to_string(stats.calls) + ",\"ticks\":" + std::to_string(stats.ticks) +
+                    ",\"size_histogram\":[";
+
+            std::size_t used = stats.size_histogram.size();
+            while (used > 0 && stats.size_histogram[used - 1] == 0)
+                used--;
+            for (std::size_t k = 0; k < used; k++)
+                json += (k == 0 ? "" : ",") + std::to_string(stats.size_histogram[k]);
+            json += "]}";
+        }
+        return json + "}}";
+    }
+};
+
+/**
+ * @brief Opt-in counters for the calculation kernels. Define BIGINT_ENABLE_INSTRUMENTATION before including bigint.hpp
+ * to turn them on. Without it the probes are empty and compile away, and snapshots are all zero.
+ * The counters are shared by all threads and are updated with relaxed atomics.
+ */
+class bigint_instrumentation
+{
+private:
+#ifdef BIGINT_ENABLE_INSTRUMENTATION
+    // Static storage, so every counter starts at zero
+    struct kernel_counters
+    {
+        std::atomic<std::uint64_t> calls;
+        std::atomic<std::uint64_t> ticks;
+        std::array<std::atomic<std::uint64_t>, 65> size_histogram;
+    };
+
+    inline static std::array<kernel_counters, static_cast<std::size_t>(bigint_kernel::count)> kernels;
+    inline static std::atomic<std::uint64_t> allocations{0};
+    inline static std::atomic<std::uint64_t> bytes_allocated{0};
+    inline static std::atomic<std::uint64_t> pool_hits{0};
+
+    /**
+     * @brief Read the clock used for the ticks
+     * @return TSC cycles on x86, nanoseconds of the steady clock elsewhere
+     */
+    static std::uint64_t now()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+#endif
+
+public:
+#ifdef BIGINT_ENABLE_INSTRUMENTATION
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    /**
+     * @brief Probe that counts a kernel call with its operand size, and adds the time until it goes out of scope.
+     * Calls during constant evaluation are not counted.
+     */
+    class scope
+    {
+    private:
+#ifdef BIGINT_ENABLE_INSTRUMENTATION
+        kernel_counters *counters = nullptr;
+        std::uint64_t start = 0;
+#endif
+
+    public:
+        /**
+         * @brief Start probing a kernel call
+         * @param kernel The kernel
+         * @param size Number of digits of the largest operand
+         */
+        constexpr scope([[maybe_unused]] bigint_kernel kernel, [[maybe_unused]] std::size_t size)
+        {
+#ifdef BIGINT_ENABLE_INSTRUMENTATION
+            if (std::is_constant_evaluated())
+                return;
+            this->counters = &kernels[static_cast<std::size_t>(kernel)];
+            this->counters->calls.fetch_add(1, std::memory_order_relaxed);
+            this->counters->size_histogram[std::bit_width(size)].fetch_add(1, std::memory_order_relaxed);
+            this->start = now();
+#endif
+        }
+
+        scope(const scope &) = delete;
+        scope &operator=(const scope &) = delete;
+
+        /**
+         * @brief Stop probing and add the elapsed time
+         */
+        constexpr ~scope()
+        {
+#ifdef BIGINT_ENABLE_INSTRUMENTATION
+            if (this->counters != nullptr)
+                this->counters->ticks.fetch_add(now() - this->start, std::memory_order_relaxed);
+#endif
+        }
+    };
+
+    /**
+     * @brief Count a buffer allocated by the scratch pool
+     * @param bytes Capacity of the buffer
+     */
+    static void record_allocation([[maybe_unused]] std::size_t bytes)
+    {
+#ifdef BIGINT_ENABLE_INSTRUMENTATION
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+#endif
+    }
+
+    /**
+     * @brief Count a buffer served by the scratch pool without allocating
+     */
+    static void record_pool_hit()
+    {
+#ifdef BIGINT_ENABLE_INSTRUMENTATION
+        pool_hits.fetch_add(1, std::memory_order_relaxed);
+#endif
+    }
+
+    /**
+     * @brief Read all counters. Counters updated by other threads meanwhile may be seen partially.
+     * @return The counters, all zero if the instrumentation is disabled
+     */
+    static bigint_stats snapshot()
+    {
+        bigint_stats stats;
+#ifdef BIGINT_ENABLE_INSTRUMENTATION
+        for (std::size_t i = 0; i < kernels.size(); i++)
+        {
+            stats.kernels[i].calls = kernels[i].calls.load(std::memory_order_relaxed);
+            stats.kernels[i].ticks = kernels[i].ticks.load(std::memory_order_relaxed);
+            for (std::size_t k = 0; k < kernels[i].size_histogram.size(); k++)
+                stats.kernels[i].size_histogram[k] = kernels[i].size_histogram[k].load(std::memory_order_relaxed);
+        }
+        stats.allocations = allocations.load(std::memory_order_relaxed);
+        stats.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+        stats.pool_hits = pool_hits.load(std::memory_order_relaxed);
+#endif
+        return stats;
+    }
+
+    /**
+     * @brief Set all counters back to zero
+     */
+    static void reset()
+    {
+#ifdef BIGINT_ENABLE_INSTRUMENTATION
+        for (kernel_counters &counters : kernels)
+        {
+            counters.calls.store(0, std::memory_order_relaxed);
+            counters.ticks.store(0, std::memory_order_relaxed);
+            for (auto &bucket : counters.size_histogram)
+                bucket.store(0, std::memory_order_relaxed);
+        }
+        allocations.store(0, std::memory_order_relaxed);
+        bytes_allocated.store(0, std::memory_order_relaxed);
+        pool_hits.store(0, std::memory_order_relaxed);
+#endif
+    }
+};
+
+/**
+ * @brief Exception thrown by a kernel when the operation running on its thread has been cancelled or has passed its deadline
+ */
+class bigint_cancelled : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Cancellation and progress reporting for long-running operations. While a control is active on a thread, the
+ * heavy kernels poll it once per row, window or sub-product. Polling throws bigint_cancelled after a stop request or
+ * after the deadline, and the outermost kernel reports its progress. Without an active control a poll is a single
+ * null check.
+ */
+class bigint_control
+{
+private:
+    std::stop_token stop;
+    std::function<void(double)> progress;
+    std::chrono::steady_clock::time_point deadline;
+    std::size_t depth = 0;       // Number of kernels running under this control
+    std::size_t last_percent = 0; // Last progress reported, in percent
+
+    inline static thread_local bigint_control *current = nullptr;
+
+    /**
+     * @brief Throw if the operation should stop, and report the progress of the outermost kernel
+     * @param done Work done by the calling kernel
+     * @param total Total work of the calling kernel
+     * @param level Depth of the calling kernel, 1 for the outermost one
+     */
+    void poll(std::size_t done, std::size_t total, std::size_t level)
+    {
+        if (this->stop.stop_requested())
+            throw bigint_cancelled("Error: Operation cancelled.");
+        if (this->deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() > this->deadline)
+            throw bigint_cancelled("Error: Deadline exceeded.");
+
+        // Only whole percents of the outermost kernel are reported, so the callback stays cheap
+        if (level == 1 && this->progress && total != 0)
+        {
+            const std::size_t percent = static_cast<std::size_t>(static_cast<double>(done) * 100 / static_cast<double>(total));
+            if (percent > this->last_percent)
+            {
+                this->last_percent = percent;
+                this->progress(static_cast<double>(done) / static_cast<double>(total));
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Control constructor
+     * @param stop Token that cancels the operation when a stop is requested
+     * @param progress Called with the finished fraction of the outermost kernel, in whole percent steps. May be empty.
+     * @param deadline Point in time after which the operation is cancelled
+     */
+    explicit bigint_control(std::stop_token stop = {}, std::function<void(double)> progress = {},
+                            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max())
+        : stop(std::move(stop)), progress(std::move(progress)), deadline(deadline)
+    {
+    }
+
+    /**
+     * @brief Control for a helper thread of the operation running on the calling thread. It shares the stop token and the
+     * deadline of the active control, and leaves progress reports to the calling thread.
+     * @return The control, which never stops if no control is active on the calling thread
+     */
+    static bigint_control for_worker()
+    {
+        if (current == nullptr)
+            return bigint_control();
+        return bigint_control(current->stop, {}, current->deadline);
+    }
+
+    /**
+     * @brief Makes a control active on the calling thread for its lifetime, restoring the previous one afterwards
+     */
+    class activation
+    {
+    private:
+        bigint_control *previous;
+
+    public:
+        /**
+         * @brief Activate a control on the calling thread
+         * @param control The control, must outlive the activation
+         */
+        explicit activation(bigint_control &control) : previous(std::exchange(current, &control))
+        {
+        }
+
+        activation(const activation &) = delete;
+        activation &operator=(const activation &) = delete;
+
+        /**
+         * @brief Restore the previous control of the thread
+         */
+        ~activation()
+        {
+            current = this->previous;
+        }
+    };
+
+    /**
+     * @brief Poll point of a kernel, created at its entry. Kernels running during constant evaluation are not polled.
+     */
+    class stage
+    {
+    private:
+        bigint_control *control = nullptr;
+        std::size_t level = 0;
+
+    public:
+        constexpr stage()
+        {
+            if (!std::is_constant_evaluated() && current != nullptr)
+            {
+                this->control = current;
+                this->level = ++this->control->depth;
+            }
+        }
+
+        stage(const stage &) = delete;
+        stage &operator=(const stage &) = delete;
+
+        constexpr ~stage()
+        {
+            if (this->control != nullptr)
+                this->control->depth--;
+        }
+
+        /**
+         * @brief Poll the active control, if any
+         * @param done Work done by the kernel so far
+         * @param total Total work of the kernel
+         */
+        constexpr void step(std::size_t done, std::size_t total)
+        {
+            if (this->control != nullptr)
+                this->control->poll(done, total, this->level);
+        }
+    };
+};
+
+class bigint_view;
+class bigint_parser;
+class bigint_accumulator;
+class bigint_tuner;
+class bigdecimal;
+class bigint_sieve;
+class bigint_parallel;
+class shared_bigint;
+
 class bigint
 {
 private:
     bool isNegative{};
     std::vector<std::uint8_t> digits;
 
+    /**
+     * @brief Operands with at least this many digits are multiplied with Karatsuba, set by BIGINT_KARATSUBA_THRESHOLD
+     */
+    static constexpr std::size_t karatsuba_threshold = BIGINT_KARATSUBA_THRESHOLD;
+    // Karatsuba splits the shorter operand at half its size, so single digits must go to schoolbook or it never ends
+    static_assert(BIGINT_KARATSUBA_THRESHOLD >= 2, "BIGINT_KARATSUBA_THRESHOLD must be at least 2");
+
+    /**
+     * @brief Thread-local pool of digit buffers used as workspace by the calculation kernels.
+     * Buffers are grouped into size classes by the power of two of their capacity. Kernels borrow a buffer with
+     * <acquire> and the buffers they replace are handed back with <release>, so steady-state arithmetic keeps reusing
+     * the same allocations instead of going through the global allocator.
+     * Only buffers of up to 1 MiB are kept, at most 8 per class, so a thread retains less than 16 MiB after a huge
+     * computation. Larger buffers are allocated and freed every time, which is cheap next to the work done on them.
+     */
+    class scratch_pool
+    {
+    private:
+        static constexpr std::size_t class_count = 21; // Classes 2^0 to 2^20
+        static constexpr std::size_t max_per_class = 8;
+
+        std::array<std::vector<std::vector<std::uint8_t>>, class_count> classes;
+
+        // Trivially destructible, so it can still be read after the pool of this thread has been destroyed
+        inline static thread_local bool alive = true;
+
+        scratch_pool()
+        {
+            for (auto &buffers : classes)
+                buffers.reserve(max_per_class);
+        }
+
+        ~scratch_pool()
+        {
+            alive = false;
+        }
+
+        /**
+         * @brief Get the pool of the calling thread
+         * @return Pointer to the pool, or nullptr if the pool has already been destroyed at thread exit
+         */
+        static scratch_pool *local()
+        {
+            if (!alive)
+                return nullptr;
+            thread_local scratch_pool pool;
+            return &pool;
+        }
+
+        /**
+         * @brief Smallest size class whose buffers can hold <size> elements
+         * @param size Number of elements required
+         * @return Index k such that 2^k >= size, or <class_count> if no class is large enough
+         */
+        static std::size_t class_for_size(std::size_t size)
+        {
+            // Sizes above the largest class are not pooled, which also keeps the shift below the width of size_t
+            std::size_t k = 0;
+            while (k < class_count && (std::size_t{1} << k) < size)
+                k++;
+            return k;
+        }
+
+        /**
+         * @brief Size class a buffer belongs to, i.e. the largest class it is guaranteed to serve
+         * @param capacity Capacity of the buffer
+         * @return Index k such that 2^k <= capacity < 2^(k+1)
+         */
+        static std::size_t class_for_capacity(std::size_t capacity)
+        {
+            std::size_t k = 0;
+            while (capacity >>= 1)
+                k++;
+            return k;
+        }
+
+    public:
+        /**
+         * @brief Borrow a zero-filled buffer of <size> digits from the pool of the calling thread
+         * @param size Number of digits needed
+         * @return A buffer of <size> zeros whose capacity is at least the next power of two of <size>
+         */
+        static constexpr std::vector<std::uint8_t> acquire(std::size_t size)
+        {
+            // Allocations made during constant evaluation are transient and cannot outlive it
+            if (std::is_constant_evaluated())
+                return std::vector<std::uint8_t>(size);
+
+            const std::size_t k = class_for_size(size);
+            scratch_pool *pool = local();
+
+            if (pool != nullptr && k < class_count && !pool->classes[k].empty())
+            {
+                std::vector<std::uint8_t> buffer = std::move(pool->classes[k].back());
+                pool->classes[k].pop_back();
+                buffer.assign(size, 0);
+                bigint_instrumentation::record_pool_hit();
+                return buffer;
+            }
+
+            std::vector<std::uint8_t> buffer;
+            buffer.reserve(k < class_count ? std::size_t{1} << k : size);
+            buffer.resize(size);
+            bigint_instrumentation::record_allocation(buffer.capacity());
+            return buffer;
+        }
+
+        /**
+         * @brief Return a buffer to the pool of the calling thread. Buffers above the largest class or of a full class
+         * are freed.
+         * @param buffer Buffer to be recycled, left empty afterwards
+         */
+        static constexpr void release(std::vector<std::uint8_t> &&buffer)
+        {
+            if (std::is_constant_evaluated() || buffer.capacity() == 0)
+                return;
+
+            const std::size_t k = class_for_capacity(buffer.capacity());
+            scratch_pool *pool = local();
+
+            if (pool != nullptr && k < class_count && pool->classes[k].size() < max_per_class)
+                pool->classes[k].push_back(std::move(buffer));
+            else
+                std::vector<std::uint8_t>().swap(buffer);
+        }
+    };
+
+    /**
+     * @brief Replace the digits with the result of a kernel and recycle the old buffer
+     * @param result Vector of digits to be stored
+     */
+    constexpr void replace_digits(std::vector<std::uint8_t> &&result)
+    {
+        scratch_pool::release(std::move(this->digits));
+        this->digits = std::move(result);
+    }
+
     /**
      * @brief Remove leading zeros during calculations or when allocating space for the vector
      * @param digits Vector of digits to be processed
      */
-    static void remove_leading_zeros(std::vector<std::uint8_t> &digits)
+    static constexpr void remove_leading_zeros(std::vector<std::uint8_t> &digits)
     {
         while (digits.size() > 1 && digits.back() == 0)
         {
@@ -26,36 +585,115 @@ private:
         }
     }
 
+    /**
+     * @brief Load 8 chars into a word, the first char in the highest byte, so the bytes of the word are in the order of
+     * <digits>. Compilers turn the loop into a single load and byte swap.
+     * @param chars Pointer to at least 8 chars
+     * @return The word
+     */
+    static constexpr std::uint64_t load_eight_chars(const char *chars)
+    {
+        std::uint64_t word = 0;
+        for (std::size_t i = 0; i < 8; i++)
+            word = word << 8 | static_cast<std::uint8_t>(chars[i]);
+        return word;
+    }
+
+    /**
+     * @brief Check 8 chars at once for decimal digits (SWAR). A byte is a digit iff its high nibble is 3 both before
+     * and after adding 6. A carry between bytes only comes from a byte that already failed the check.
+     * @param word Chars loaded by <load_eight_chars>
+     * @return True iff all 8 chars are decimal digits
+     */
+    static constexpr bool is_eight_digits(std::uint64_t word)
+    {
+        constexpr std::uint64_t high_nibbles = 0xF0F0F0F0F0F0F0F0;
+        return ((word & high_nibbles) | (((word + 0x0606060606060606) & high_nibbles) >> 4)) == 0x3333333333333333;
+    }
+
+    /**
+     * @brief Length of the run of decimal digits at the start of a string, checked 8 chars at a time
+     * @param str String to be scanned
+     * @return Number of leading digit chars
+     */
+    static constexpr std::size_t count_leading_digits(std::string_view str)
+    {
+        std::size_t i = 0;
+        while (i + 8 <= str.size() && is_eight_digits(load_eight_chars(str.data() + i)))
+            i += 8;
+        while (i < str.size() && str[i] >= '0' && str[i] <= '9')
+            i++;
+        return i;
+    }
+
+    /**
+     * @brief Store validated decimal digit chars into a vector of digits, 8 digits per step. The vector is resized in
+     * place, so its buffer is reused.
+     * @param str Non-empty string of decimal digits, most significant first
+     * @param digits Vector to receive the digits, least significant first and without leading zeros
+     */
+    static constexpr void store_digit_chars(std::string_view str, std::vector<std::uint8_t> &digits)
+    {
+        const std::size_t size = str.size();
+        digits.resize(size);
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            // Subtracting '0' from every byte cannot borrow, since every byte is a digit
+            const std::uint64_t word = load_eight_chars(str.data() + i) - 0x3030303030303030;
+            for (std::size_t k = 0; k < 8; k++)
+                digits[size - 8 - i + k] = static_cast<std::uint8_t>(word >> (8 * k));
+        }
+        for (; i < size; i++)
+            digits[size - 1 - i] = static_cast<std::uint8_t>(str[i] - '0');
+        remove_leading_zeros(digits);
+    }
+
+    /**
+     * @brief Write digits as chars, most significant first, 8 chars per step. Adding '0' to every byte cannot carry.
+     * @param digits Digits to be written, least significant first
+     * @param out Buffer of at least digits.size() chars
+     */
+    static constexpr void write_digit_chars(std::span<const std::uint8_t> digits, char *out)
+    {
+        const std::size_t size = digits.size();
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            // Byte k of the word holds the char at out[i + k]
+            std::uint64_t word = 0;
+            for (std::size_t k = 8; k > 0; k--)
+                word = word << 8 | digits[size - i - k];
+            word += 0x3030303030303030;
+            for (std::size_t k = 0; k < 8; k++)
+                out[i + k] = static_cast<char>(word >> (8 * k));
+        }
+        for (; i < size; i++)
+            out[i] = static_cast<char>('0' + digits[size - 1 - i]);
+    }
+
     /**
      * @brief Turn the string representation into the vector of digit and handle the sign.
      * @param str String to be converted into bigint
      */
-    void str_to_bigint(const std::string &str)
+    constexpr void str_to_bigint(std::string_view str)
     {
-        this->isNegative = str[0] == '-';
-        size_t start = 0;
+        const bigint_instrumentation::scope probe(bigint_kernel::parse, str.size());
+        const bool negative = str[0] == '-';
 
         if (str[0] == '-' || str[0] == '+')
         {
             if (str.size() == 1)
                 throw std::invalid_argument("Error: String contains only a sign char.");
-            start = 1;
+            str.remove_prefix(1);
         }
 
-        for (size_t i = str.length(); i > start; i--)
-        {
-            if (!std::isdigit(str[i - 1]))
-            {
-                throw std::invalid_argument("Error: String contains non-digit char.");
-            }
-            // Reference: https://stackoverflow.com/questions/5029840/convert-char-to-int-in-c-and-c
-            digits.push_back(static_cast<std::uint8_t>(str[i - 1] - '0'));
-        }
+        if (count_leading_digits(str) != str.size())
+            throw std::invalid_argument("Error: String contains non-digit char.");
+        store_digit_chars(str, this->digits);
 
         // Handle negative zero
-        remove_leading_zeros(this->digits);
-        if (is_abs_zero(this->digits))
-            this->isNegative = false;
+        this->isNegative = negative && !is_abs_zero(this->digits);
     }
 
     /**
@@ -64,7 +702,7 @@ private:
      * @param rhs Vector of digits of the second number
      * @return True iff lhs is less than rhs
      */
-    static bool is_abs_less_than(const std::vector<std::uint8_t> &lhs, const std::vector<std::uint8_t> &rhs)
+    static constexpr bool is_abs_less_than(std::span<const std::uint8_t> lhs, std::span<const std::uint8_t> rhs)
     {
         if (lhs.size() != rhs.size())
             return lhs.size() < rhs.size();
@@ -83,7 +721,7 @@ private:
      * @param num Vector of digits to be checked
      * @return True iff the number is zero
      */
-    static bool is_abs_zero(const std::vector<std::uint8_t> &num)
+    static constexpr bool is_abs_zero(std::span<const std::uint8_t> num)
     {
         return num.size() == 1 && num[0] == 0;
     }
@@ -94,11 +732,11 @@ private:
      * @param shorter Vector of digits of the second number
      * @return A vector of digits smaller the sum of the two numbers' absolute values
      */
-    static std::vector<std::uint8_t>
-    add_abs(const std::vector<std::uint8_t> &longer, const std::vector<std::uint8_t> &shorter)
+    static constexpr std::vector<std::uint8_t>
+    add_abs(std::span<const std::uint8_t> longer, std::span<const std::uint8_t> shorter)
     {
-        std::vector<std::uint8_t> result(longer.size());
-        result.reserve(result.size() + 1); // Max size, e.g. 999 + 999 = 1998 -> 4 digits
+        const bigint_instrumentation::scope probe(bigint_kernel::add, longer.size());
+        std::vector<std::uint8_t> result = scratch_pool::acquire(longer.size() + 1); // Max size, e.g. 999 + 999 = 1998 -> 4 digits
 
         std::uint8_t carry = 0;
 
@@ -113,7 +751,9 @@ private:
         }
 
         if (carry != 0)
-            result.push_back(carry);
+            result.back() = carry;
+        else
+            result.pop_back();
         return result;
     }
 
@@ -123,11 +763,11 @@ private:
      * @param small Vector of digits of the smaller number
      * @return A vector of digits representing the difference of the two numbers' absolute values
      */
-    static std::vector<std::uint8_t> subtract_abs(const std::vector<std::uint8_t> &big,
-                                                  const std::vector<std::uint8_t> &small)
+    static constexpr std::vector<std::uint8_t> subtract_abs(std::span<const std::uint8_t> big,
+                                                  std::span<const std::uint8_t> small)
     {
-        std::vector<std::uint8_t> result;
-        result.reserve(big.size()); // Min size, e.g. 999 - 0 = 999 -> 3 digits
+        const bigint_instrumentation::scope probe(bigint_kernel::subtract, big.size());
+        std::vector<std::uint8_t> result = scratch_pool::acquire(big.size()); // Min size, e.g. 999 - 0 = 999 -> 3 digits
 
         std::uint8_t borrow = 0;
 
@@ -149,28 +789,29 @@ private:
             {
                 borrow = 0;
             }
-            result.push_back(static_cast<std::uint8_t>(diff));
+            result[i] = static_cast<std::uint8_t>(diff);
         }
 
         return result;
     }
 
     /**
-     * @brief Multiply the absolute values of two numbers
+     * @brief Multiply the absolute values of two numbers with vertical multiplication
      * @param lhs Vector of digits of the first number
      * @param rhs Vector of digits of the second number
-     * @return A vector of digits representing the product of the two numbers' absolute values
+     * @return A vector of digits representing the product of the two numbers' absolute values, may have leading zeros
      */
-    static std::vector<std::uint8_t> multiply_abs(const std::vector<std::uint8_t> &lhs,
-                                                  const std::vector<std::uint8_t> &rhs)
+    static constexpr std::vector<std::uint8_t> multiply_schoolbook(std::span<const std::uint8_t> lhs,
+                                                                   std::span<const std::uint8_t> rhs)
     {
+        const bigint_instrumentation::scope probe(bigint_kernel::multiply_schoolbook, std::max(lhs.size(), rhs.size()));
         if (is_abs_zero(lhs) || is_abs_zero(rhs))
-            return {0};
+            return scratch_pool::acquire(1);
 
-        std::vector<std::uint8_t> result;
-        result.resize(lhs.size() + rhs.size()); // Max size, e.g. 999 * 999 = 998001 -> 6 digits
+        std::vector<std::uint8_t> result = scratch_pool::acquire(lhs.size() + rhs.size()); // Max size, e.g. 999 * 999 = 998001 -> 6 digits
 
         // In vertical multiplication form, it does not matter if the lhs or rhs is above the other, it will result in the same addition pattern.
+        bigint_control::stage stage;
         for (std::size_t i = 0; i < lhs.size(); i++)
         {
             std::uint8_t carry = 0;
@@ -189,380 +830,3420 @@ private:
             {
                 result[i + rhs.size()] = carry;
             }
+            stage.step(i + 1, lhs.size());
         }
         return result;
     }
 
     /**
-     * @brief Divide the absolute values of two numbers
-     * @param dividend Vector of digits of the dividend
-     * @param divisor Vector of digits of the divisor
-     * @return A vector of digits representing the quotient of the two numbers' absolute values
+     * @brief Drop the leading zeros of a span of digits, keeping a single 0 for zero
+     * @param num Digits, least significant first
+     * @return The digits without leading zeros
      */
-    static std::vector<std::uint8_t> divide_abs(const std::vector<std::uint8_t> &dividend, const std::vector<std::uint8_t> &divisor)
+    static constexpr std::span<const std::uint8_t> trim_digits(std::span<const std::uint8_t> num)
     {
-        // Reference: https://stackoverflow.com/questions/6121623/catching-exception-divide-by-zero
-        if (is_abs_zero(divisor))
-            throw std::logic_error("Division by zero");
-        if (is_abs_zero(dividend) || is_abs_less_than(dividend, divisor))
-            return {0};
-
-        std::vector<std::uint8_t> quotient(dividend.size());
-        std::vector<std::uint8_t> current_sum(dividend.size());
-        current_sum.reserve(current_sum.size() + 1); // Max size, e.g. For 999/998, we have 998 + 998 = 1996 -> 4 digits
-
-        while (!is_abs_less_than(dividend, current_sum))
-        {
-            current_sum = add_abs(current_sum, divisor);
-            quotient = add_abs(quotient, {1});
-        }
-
-        // Is always greater than the dividend, subtract one from the quotient
-        quotient = subtract_abs(quotient, {1});
-
-        return quotient;
+        while (num.size() > 1 && num.back() == 0)
+            num = num.first(num.size() - 1);
+        return num;
     }
 
-public:
     /**
-     * @brief Default constructor: Initialize the number to zero
+     * @brief Add <addend> into <acc> in place. The sum must fit in <acc>.
+     * @param acc Digits to be added to, a window of a larger result
+     * @param addend Digits to be added, not longer than <acc>
      */
-    explicit bigint()
+    static constexpr void add_into(std::span<std::uint8_t> acc, std::span<const std::uint8_t> addend)
     {
-        isNegative = false;
-        digits.push_back(0);
+        std::uint8_t carry = 0;
+        for (std::size_t i = 0; i < acc.size() && (i < addend.size() || carry); i++)
+        {
+            const std::uint8_t sum = acc[i] + (i < addend.size() ? addend[i] : 0) + carry;
+            acc[i] = sum % 10;
+            carry = sum / 10;
+        }
     }
 
     /**
-     * @brief Int64 constructor: Initialize the number to the given integer
-     * @param num Integer to be converted to bigint
+     * @brief Subtract <subtrahend> from <acc> in place. The magnitude of <acc> must not be less than <subtrahend>.
+     * @param acc Digits to be subtracted from
+     * @param subtrahend Digits to be subtracted
      */
-    explicit bigint(std::int64_t num)
+    static constexpr void subtract_from(std::span<std::uint8_t> acc, std::span<const std::uint8_t> subtrahend)
     {
-        // Handle overflow when converting to abs
-        // Reference: https://stackoverflow.com/questions/16033201/smallest-values-for-int8-t-and-int64-t
-        if (num == std::numeric_limits<std::int64_t>::min())
+        std::uint8_t borrow = 0;
+        for (std::size_t i = 0; i < acc.size() && (i < subtrahend.size() || borrow); i++)
         {
-            *this = bigint(std::to_string(num));
-            return;
+            const std::uint8_t sub = (i < subtrahend.size() ? subtrahend[i] : 0) + borrow;
+            borrow = acc[i] < sub;
+            acc[i] = static_cast<std::uint8_t>(acc[i] + (borrow ? 10 : 0) - sub);
         }
-
-        isNegative = num < 0;
-        num = std::abs(num);
-        if (num == 0)
-        {
-            digits.push_back(0);
-        }
-        else
-        {
-            while (num != 0)
-            {
-                digits.push_back(static_cast<std::uint8_t>(num % 10));
-                num /= 10;
-            }
-        }
-    }
+    }
 
     /**
-     * @brief String constructor: Initialize the number to the given string
-     * @param str String to be converted to bigint
+     * @brief Multiply the absolute values of two numbers of about the same size with one level of Karatsuba.
+     * With x = x1 * 10^m + x0 and y = y1 * 10^m + y0, the product is z2 * 10^2m + z1 * 10^m + z0, where z0 = x0 * y0,
+     * z2 = x1 * y1 and z1 = (x0 + x1)(y0 + y1) - z0 - z2. Three half-size products replace four.
+     * @param lhs Digits of the first number without leading zeros
+     * @param rhs Digits of the second number without leading zeros, more than half as long as <lhs> and vice versa
+     * @param threshold Operands shorter than this are multiplied by <multiply_schoolbook>
+     * @return A vector of digits representing the product, may have leading zeros
      */
-    explicit bigint(const std::string &str)
+    static constexpr std::vector<std::uint8_t> multiply_karatsuba(std::span<const std::uint8_t> lhs,
+                                                                  std::span<const std::uint8_t> rhs, std::size_t threshold)
     {
-        if (str.empty())
-            throw std::invalid_argument("Empty string is not permitted");
-        str_to_bigint(str);
+        const bigint_instrumentation::scope probe(bigint_kernel::multiply_karatsuba, std::max(lhs.size(), rhs.size()));
+        const std::size_t m = std::max(lhs.size(), rhs.size()) / 2;
+        const std::span<const std::uint8_t> x0 = trim_digits(lhs.first(m));
+        const std::span<const std::uint8_t> x1 = lhs.subspan(m);
+        const std::span<const std::uint8_t> y0 = trim_digits(rhs.first(m));
+        const std::span<const std::uint8_t> y1 = rhs.subspan(m);
+
+        // x1 is never shorter than x0, but y0 may be longer than y1
+        std::vector<std::uint8_t> x_sum = add_abs(x1, x0);
+        std::vector<std::uint8_t> y_sum;
+        if (y0.size() < y1.size())
+            y_sum = add_abs(y1, y0);
+        else
+            y_sum = add_abs(y0, y1);
+        bigint_control::stage stage;
+        std::vector<std::uint8_t> z0 = multiply_dispatch(x0, y0, threshold);
+        stage.step(1, 3);
+        std::vector<std::uint8_t> z1 = multiply_dispatch(trim_digits(x_sum), trim_digits(y_sum), threshold);
+        stage.step(2, 3);
+        std::vector<std::uint8_t> z2 = multiply_dispatch(x1, y1, threshold);
+        stage.step(3, 3);
+
+        std::vector<std::uint8_t> result = scratch_pool::acquire(lhs.size() + rhs.size());
+        const std::span<const std::uint8_t> low = trim_digits(z0);
+        const std::span<const std::uint8_t> high = trim_digits(z2);
+        std::copy(low.begin(), low.end(), result.begin());
+        std::copy(high.begin(), high.end(), result.begin() + 2 * m);
+
+        subtract_from(z1, low);
+        subtract_from(z1, high);
+        add_into(std::span<std::uint8_t>(result).subspan(m), trim_digits(z1));
+
+        for (std::vector<std::uint8_t> *buffer : {&x_sum, &y_sum, &z0, &z1, &z2})
+            scratch_pool::release(std::move(*buffer));
+        return result;
     }
 
     /**
-     * @brief Negation operator: transform the current number to its negation
-     * @return The negation of the current number
+     * @brief Multiply the absolute values of two numbers, choosing the algorithm by the size of the operands.
+     * A long operand times a much shorter one is cut into pieces as long as the shorter one, so every product is balanced.
+     * @param lhs Digits of the first number without leading zeros
+     * @param rhs Digits of the second number without leading zeros
+     * @param threshold Operands shorter than this are multiplied by <multiply_schoolbook>, longer ones by <multiply_karatsuba>
+     * @return A vector of digits representing the product, may have leading zeros
      */
-    bigint operator-() const
+    static constexpr std::vector<std::uint8_t> multiply_dispatch(std::span<const std::uint8_t> lhs,
+                                                                 std::span<const std::uint8_t> rhs, std::size_t threshold)
     {
-        // Reference: https://www.geeksforgeeks.org/shallow-copy-and-deep-copy-in-c/
-        bigint negative = *this;
+        if (lhs.size() < rhs.size())
+            std::swap(lhs, rhs);
+        if (is_abs_zero(rhs))
+            return scratch_pool::acquire(1);
+        if (rhs.size() < std::max<std::size_t>(threshold, 2)) // Same floor as the static_assert, for tuned thresholds
+            return multiply_schoolbook(lhs, rhs);
+        if (2 * rhs.size() > lhs.size())
+            return multiply_karatsuba(lhs, rhs, threshold);
 
-        // Ignore negative zero to avoid unexpected behavior
-        if (!(negative.digits.size() == 1 && negative.digits[0] == 0))
+        std::vector<std::uint8_t> result = scratch_pool::acquire(lhs.size() + rhs.size());
+        bigint_control::stage stage;
+        for (std::size_t offset = 0; offset < lhs.size(); offset += rhs.size())
         {
-            negative.isNegative = !negative.isNegative;
+            const std::size_t length = std::min(rhs.size(), lhs.size() - offset);
+            std::vector<std::uint8_t> partial = multiply_dispatch(trim_digits(lhs.subspan(offset, length)), rhs, threshold);
+            add_into(std::span<std::uint8_t>(result).subspan(offset), trim_digits(partial));
+            scratch_pool::release(std::move(partial));
+            stage.step(offset + length, lhs.size());
         }
-
-        return negative;
+        return result;
     }
 
     /**
-     * @brief Increment operator (prefix): Add 1 to the current number
-     * @return The incremented number
+     * @brief Multiply the absolute values of two numbers with the algorithm picked by <karatsuba_threshold>
+     * @param lhs Vector of digits of the first number
+     * @param rhs Vector of digits of the second number
+     * @return A vector of digits representing the product of the two numbers' absolute values, may have leading zeros
      */
-    bigint &operator++()
+    static constexpr std::vector<std::uint8_t> multiply_abs(std::span<const std::uint8_t> lhs,
+                                                  std::span<const std::uint8_t> rhs)
     {
-        *this += bigint(1);
-        return *this;
+        return multiply_dispatch(lhs, rhs, karatsuba_threshold);
     }
 
     /**
-     * @brief Increment operator (postfix): Add 1 to the current number
-     * @return The original number before increment
+     * @brief Add the absolute value of <addend> to <acc> in place. <acc> may be shorter or longer than <addend>.
+     * @param acc Vector of digits to be added to, keeps its leading zeros
+     * @param addend Vector of digits to be added
      */
-    bigint operator++(int)
+    static constexpr void add_abs_in_place(std::vector<std::uint8_t> &acc, std::span<const std::uint8_t> addend)
     {
-        bigint temp = *this;
-        *this += bigint(1);
-        return temp;
+        const bigint_instrumentation::scope probe(bigint_kernel::add, std::max(acc.size(), addend.size()));
+        if (acc.size() < addend.size())
+            acc.resize(addend.size());
+
+        std::uint8_t carry = 0;
+
+        for (std::size_t i = 0; i < acc.size() && (i < addend.size() || carry != 0); i++)
+        {
+            std::uint8_t sum = carry + acc[i];
+            if (i < addend.size())
+                sum += addend[i];
+
+            acc[i] = sum % 10;
+            carry = sum / 10;
+        }
+
+        if (carry != 0)
+            acc.push_back(carry);
     }
 
     /**
-     * @brief Decrement operator (prefix): Subtract 1 from the current number
-     * @return The decremented number
+     * @brief Add one to the absolute value of <num> in place
+     * @param num Vector of digits to be incremented
      */
-    bigint &operator--()
+    static constexpr void add_one_in_place(std::vector<std::uint8_t> &num)
     {
-        *this -= bigint(1);
-        return *this;
+        for (auto &digit : num)
+        {
+            if (digit != 9)
+            {
+                digit++;
+                return;
+            }
+            digit = 0;
+        }
+        num.push_back(1);
     }
 
     /**
-     * @brief Decrement operator (postfix): Subtract 1 from the current number
-     * @return The original number before decrement
+     * @brief Subtract one from the absolute value of <num> in place. <num> must not be zero.
+     * @param num Vector of digits to be decremented, keeps its leading zeros
      */
-    bigint operator--(int)
+    static constexpr void subtract_one_in_place(std::vector<std::uint8_t> &num)
     {
-        bigint temp = *this;
-        *this -= bigint(1);
-        return temp;
+        for (auto &digit : num)
+        {
+            if (digit != 0)
+            {
+                digit--;
+                return;
+            }
+            digit = 9;
+        }
     }
 
     /**
-     * @brief Addition Assignment Operator: Add <rhs> to the current number
-     * @param rhs Number to be added to the current number
-     * @return The current number after addition
+     * @brief Divide the absolute values of two numbers with schoolbook long division
+     * @param dividend Vector of digits of the dividend
+     * @param divisor Vector of digits of the divisor
+     * @param quotient Receives the digits of the quotient of the two numbers' absolute values
+     * @param remainder Receives the digits of the remainder of the two numbers' absolute values
      */
-    bigint &operator+=(const bigint &rhs)
+    static constexpr void divmod_abs(std::span<const std::uint8_t> dividend, std::span<const std::uint8_t> divisor,
+                                     std::vector<std::uint8_t> &quotient, std::vector<std::uint8_t> &remainder)
     {
-        // Add abs values if signs are the same
-        if (this->isNegative == rhs.isNegative)
+        const bigint_instrumentation::scope probe(bigint_kernel::divide_schoolbook, dividend.size());
+        // Reference: https://stackoverflow.com/questions/6121623/catching-exception-divide-by-zero
+        if (is_abs_zero(divisor))
+            throw std::logic_error("Division by zero");
+
+        if (is_abs_less_than(dividend, divisor))
         {
-            if (this->digits.size() > rhs.digits.size())
-            {
-                this->digits = add_abs(this->digits, rhs.digits);
-            }
-            else
-            {
-                this->digits = add_abs(rhs.digits, this->digits);
-            }
+            quotient = scratch_pool::acquire(1);
+            remainder = scratch_pool::acquire(dividend.size());
+            std::copy(dividend.begin(), dividend.end(), remainder.begin());
+            return;
         }
-        else
+
+        // The remainder starts as a copy of the dividend. Each step reduces a window of divisor.size() + 1 digits, which
+        // is always less than 10 times the divisor, so every quotient digit takes at most 9 subtractions.
+        const std::size_t width = divisor.size();
+        remainder = scratch_pool::acquire(dividend.size() + 1);
+        std::copy(dividend.begin(), dividend.end(), remainder.begin());
+        quotient = scratch_pool::acquire(dividend.size() - width + 1);
+
+        bigint_control::stage stage;
+        for (std::size_t i = quotient.size(); i > 0; i--)
         {
-            if (is_abs_less_than(this->digits, rhs.digits))
+            std::uint8_t *window = remainder.data() + i - 1;
+            while (true)
             {
-                // Since two nums are different signs, order of subtraction does not matter but we need to follow the sign of the larger number
-                this->digits = subtract_abs(rhs.digits, this->digits);
+                // Compare the window with the divisor, the top digit of the window is above the divisor
+                if (window[width] == 0)
+                {
+                    std::size_t j = width;
+                    while (j > 0 && window[j - 1] == divisor[j - 1])
+                        j--;
+                    if (j > 0 && window[j - 1] < divisor[j - 1])
+                        break;
+                }
 
-                // If lhs is small positive, rhs is large negative -> result is negative -> follow rhs sign
-                // If lhs is small negative, rhs is large positive -> result is positive -> follow rhs sign
-                this->isNegative = rhs.isNegative;
-            }
-            else
-            {
-                this->digits = subtract_abs(this->digits, rhs.digits);
+                std::uint8_t borrow = 0;
+                for (std::size_t j = 0; j <= width; j++)
+                {
+                    const std::uint8_t subtrahend = (j < width ? divisor[j] : 0) + borrow;
+                    borrow = window[j] < subtrahend;
+                    window[j] = static_cast<std::uint8_t>(window[j] + (borrow ? 10 : 0) - subtrahend);
+                }
+                quotient[i - 1]++;
             }
+            stage.step(quotient.size() - i + 1, quotient.size());
         }
 
-        remove_leading_zeros(this->digits);
-        if (is_abs_zero(this->digits))
-            this->isNegative = false;
-
-        return *this;
+        remove_leading_zeros(quotient);
+        remove_leading_zeros(remainder);
     }
 
     /**
-     * @brief Subtraction Assignment Operator: Subtract another number from the current number
-     * @param rhs Number to be subtracted from the current number
-     * @return The current number after subtraction
+     * @brief Divide the absolute values of two numbers
+     * @param dividend Vector of digits of the dividend
+     * @param divisor Vector of digits of the divisor
+     * @return A vector of digits representing the quotient of the two numbers' absolute values
      */
-    bigint &operator-=(const bigint &rhs)
+    static constexpr std::vector<std::uint8_t> divide_abs(std::span<const std::uint8_t> dividend, std::span<const std::uint8_t> divisor)
     {
-        *this += -rhs;
-        return *this;
+        std::vector<std::uint8_t> quotient;
+        std::vector<std::uint8_t> remainder;
+        divmod_abs(dividend, divisor, quotient, remainder);
+        scratch_pool::release(std::move(remainder));
+        return quotient;
     }
 
     /**
-     * @brief Multiplication Assignment Operator: Multiply another number to the current number
-     * @param rhs Number to be multiplied to the current number
-     * @return The current number after multiplication
+     * @brief Magnitude constructor: Take over a new buffer of digits, trimming its leading zeros
+     * @param magnitude Digits of the magnitude, least significant first
+     * @param negative Sign of the number, dropped if the magnitude is zero
      */
-    bigint &operator*=(const bigint &rhs)
+    constexpr bigint(std::vector<std::uint8_t> &&magnitude, bool negative) : isNegative(negative), digits(std::move(magnitude))
     {
-        this->isNegative = this->isNegative != rhs.isNegative;
-        this->digits = multiply_abs(this->digits, rhs.digits);
         remove_leading_zeros(this->digits);
         if (is_abs_zero(this->digits))
             this->isNegative = false;
-        return *this;
     }
 
     /**
-     * @brief Division Assignment Operator: Divide the current number by another number
-     * @param rhs Number to divide the current number by
-     * @return The current number after division
+     * @brief Add two signed magnitudes into a new buffer, reading both in place
+     * @param lhs Digits of the magnitude of the first number
+     * @param lhs_negative Sign of the first number
+     * @param rhs Digits of the magnitude of the second number
+     * @param rhs_negative Sign of the second number
+     * @return The sum
+     */
+    static constexpr bigint signed_sum(std::span<const std::uint8_t> lhs, bool lhs_negative,
+                                       std::span<const std::uint8_t> rhs, bool rhs_negative)
+    {
+        // Add abs values if signs are the same
+        if (lhs_negative == rhs_negative)
+            return bigint(lhs.size() > rhs.size() ? add_abs(lhs, rhs) : add_abs(rhs, lhs), lhs_negative);
+
+        // Since two nums are different signs, order of subtraction does not matter but we need to follow the sign of the larger number
+        // If lhs is small positive, rhs is large negative -> result is negative -> follow rhs sign
+        // If lhs is small negative, rhs is large positive -> result is positive -> follow rhs sign
+        if (is_abs_less_than(lhs, rhs))
+            return bigint(subtract_abs(rhs, lhs), rhs_negative);
+        return bigint(subtract_abs(lhs, rhs), lhs_negative);
+    }
+
+    /**
+     * @brief Multiply two signed magnitudes into a new buffer, reading both in place
+     * @param lhs Digits of the magnitude of the first number
+     * @param lhs_negative Sign of the first number
+     * @param rhs Digits of the magnitude of the second number
+     * @param rhs_negative Sign of the second number
+     * @return The product
+     */
+    static constexpr bigint signed_product(std::span<const std::uint8_t> lhs, bool lhs_negative,
+                                           std::span<const std::uint8_t> rhs, bool rhs_negative)
+    {
+        return bigint(multiply_abs(lhs, rhs), lhs_negative != rhs_negative);
+    }
+
+    /**
+     * @brief Divide two signed magnitudes into a new buffer, reading both in place
+     * @param lhs Digits of the magnitude of the dividend
+     * @param lhs_negative Sign of the dividend
+     * @param rhs Digits of the magnitude of the divisor
+     * @param rhs_negative Sign of the divisor
+     * @return The quotient, truncated toward zero
      */
-    bigint &operator/=(const bigint &rhs)
+    static constexpr bigint signed_quotient(std::span<const std::uint8_t> lhs, bool lhs_negative,
+                                            std::span<const std::uint8_t> rhs, bool rhs_negative)
     {
-        if (is_abs_zero(rhs.digits))
+        if (is_abs_zero(rhs))
         {
             // Reference https://stackoverflow.com/questions/6121623/catching-exception-divide-by-zero
             throw std::logic_error("Error: Division by zero");
         }
-
-        this->isNegative = this->isNegative != rhs.isNegative;
-        this->digits = divide_abs(this->digits, rhs.digits);
-
-        remove_leading_zeros(this->digits);
-        if (is_abs_zero(this->digits))
-            this->isNegative = false;
-        return *this;
+        return bigint(divide_abs(lhs, rhs), lhs_negative != rhs_negative);
     }
 
     /**
-     * @brief Addition Operator: Add two numbers
-     * @param lhs The first number to be added
-     * @param rhs The second number to be added
-     * @return A new number that is the sum of the two numbers
+     * @brief Remainder of the division of two signed magnitudes into a new buffer, reading both in place. The remainder
+     * has the sign of the dividend, so it matches the truncated quotient of <signed_quotient>.
+     * @param lhs Digits of the magnitude of the dividend
+     * @param lhs_negative Sign of the dividend
+     * @param rhs Digits of the magnitude of the divisor, the sign of the divisor does not affect the remainder
+     * @return The remainder
      */
-    friend bigint operator+(bigint lhs, const bigint &rhs)
+    static constexpr bigint signed_remainder(std::span<const std::uint8_t> lhs, bool lhs_negative,
+                                             std::span<const std::uint8_t> rhs)
     {
-        // Friend functions to allow using compound assignment operators as it will call private parameters.
-        return lhs += rhs;
+        if (is_abs_zero(rhs))
+            throw std::logic_error("Error: Division by zero");
+
+        std::vector<std::uint8_t> quotient;
+        std::vector<std::uint8_t> remainder;
+        divmod_abs(lhs, rhs, quotient, remainder);
+        scratch_pool::release(std::move(quotient));
+        return bigint(std::move(remainder), lhs_negative);
     }
 
     /**
-     * @brief Subtraction Operator: Subtract two numbers
-     * @param lhs The number to be subtracted from
-     * @param rhs THe number to be subtracted
-     * @return A new number that is the difference of the two numbers
+     * @brief Add a signed magnitude to the current number
+     * @param rhs Digits of the magnitude to be added
+     * @param rhs_negative Sign of the number to be added
      */
-    friend bigint operator-(bigint lhs, const bigint &rhs)
+    constexpr void add_signed(std::span<const std::uint8_t> rhs, bool rhs_negative)
     {
-        return lhs -= rhs;
+        *this = signed_sum(this->digits, this->isNegative, rhs, rhs_negative);
     }
 
     /**
-     * @brief Multiplication Operator: Multiply two numbers
-     * @param lhs The first number to be multiplied
-     * @param rhs The second number to be multiplied
-     * @return A new number that is the product of the two numbers
+     * @brief Multiply the current number by a signed magnitude
+     * @param rhs Digits of the magnitude to be multiplied
+     * @param rhs_negative Sign of the number to be multiplied
      */
-    friend bigint operator*(bigint lhs, const bigint &rhs)
+    constexpr void multiply_signed(std::span<const std::uint8_t> rhs, bool rhs_negative)
     {
-        return lhs *= rhs;
+        *this = signed_product(this->digits, this->isNegative, rhs, rhs_negative);
     }
 
     /**
-     * @brief Division Operator: Divide two numbers
-     * @param lhs The number to be divided
-     * @param rhs The number to divide by
-     * @return A new number that is the quotient of the two numbers
+     * @brief Divide the current number by a signed magnitude
+     * @param rhs Digits of the magnitude to divide by
+     * @param rhs_negative Sign of the number to divide by
      */
-    friend bigint operator/(bigint lhs, const bigint &rhs)
+    constexpr void divide_signed(std::span<const std::uint8_t> rhs, bool rhs_negative)
     {
-        return lhs /= rhs;
+        *this = signed_quotient(this->digits, this->isNegative, rhs, rhs_negative);
     }
 
     /**
-     * @brief Equality Operator: Check if two numbers are equal
-     * @param rhs The number to be compared with
-     * @return True iff the two numbers are equal
+     * @brief Replace the current number by the remainder of its division by a signed magnitude. The remainder has the sign of
+     * the dividend, so it matches the truncated quotient of <divide_signed>.
+     * @param rhs Digits of the magnitude of the divisor, the sign of the divisor does not affect the remainder
      */
-    bool operator==(const bigint &rhs) const
+    constexpr void modulo_signed(std::span<const std::uint8_t> rhs)
     {
-        // Reference: https://learn.microsoft.com/en-us/cpp/cpp/equality-operators-equal-equal-and-exclpt-equal?view=msvc-170
-        // In c++, == compares the value of obj, not the address
-        return this->isNegative == rhs.isNegative && this->digits == rhs.digits;
+        *this = signed_remainder(this->digits, this->isNegative, rhs);
     }
 
     /**
-     * @brief Inequality Operator: Check if two numbers are not equal
-     * @param rhs The number to be compared with
-     * @return True iff the two numbers are not equal
+     * @brief Add or subtract <b> * <factor> * 10^<shift> to the magnitude in <acc> in one fused pass
+     * The factor is split into factor / 10 and factor % 10, so the carry and the borrow stay below 2^64.
+     * @param acc Vector of digits updated in place, must have at least b.size() + <shift> digits
+     * @param b Vector of digits of the number to be multiplied
+     * @param factor Word to multiply <b> by
+     * @param shift Power of ten the product is shifted by
+     * @param subtract True to subtract the product instead of adding it
+     * @return The borrow left over past the top digit when subtracting, 0 when adding
      */
-    bool operator!=(const bigint &rhs) const
+    static constexpr std::uint64_t multiply_accumulate_in_place(std::vector<std::uint8_t> &acc,
+                                                                std::span<const std::uint8_t> b, std::uint64_t factor,
+                                                                std::size_t shift, bool subtract)
     {
-        return !(*this == rhs);
+        const std::uint64_t high = factor / 10;
+        const std::uint64_t low = factor % 10;
+        std::uint64_t carry = 0;
+        std::size_t k = shift;
+
+        for (std::size_t i = 0; i < b.size() || (carry != 0 && (!subtract || k < acc.size())); i++, k++)
+        {
+            const std::uint64_t digit = i < b.size() ? b[i] : 0;
+            if (k == acc.size())
+                acc.push_back(0);
+
+            if (!subtract)
+            {
+                const std::uint64_t curr = acc[k] + digit * low + carry;
+                acc[k] = static_cast<std::uint8_t>(curr % 10);
+                carry = digit * high + curr / 10;
+            }
+            else
+            {
+                // Borrow just enough tens to make the digit non-negative
+                const std::uint64_t take = digit * low + carry;
+                std::uint64_t tens = 0;
+                if (take > acc[k])
+                {
+                    tens = (take - acc[k] + 9) / 10;
+                    acc[k] = static_cast<std::uint8_t>(acc[k] + tens * 10 - take);
+                }
+                else
+                {
+                    acc[k] = static_cast<std::uint8_t>(acc[k] - take);
+                }
+                carry = digit * high + tens;
+            }
+        }
+
+        return subtract ? carry : 0;
     }
 
     /**
-     * @brief Less Than Operator: Check if the current number is less than another number
-     * @param rhs The number to be compared with
-     * @return True iff the current number is less than <rhs>
+     * @brief Add a signed product to the current number without building the product first
+     * @param b Digits of the magnitude of the first factor
+     * @param c Digits of the magnitude of the second factor, ignored if <word> is not zero
+     * @param word Magnitude of a word-sized second factor, or 0 to use <c>
+     * @param product_negative Sign of the product
      */
-    bool operator<(const bigint &rhs) const
+    constexpr void accumulate_product(std::span<const std::uint8_t> b, std::span<const std::uint8_t> c,
+                                      std::uint64_t word, bool product_negative)
     {
-        if (this->isNegative && !rhs.isNegative)
+        const bigint_instrumentation::scope probe(bigint_kernel::fused_multiply_add, std::max({this->digits.size(), b.size(), c.size()}));
+        if (is_abs_zero(b) || (word == 0 && is_abs_zero(c)))
+            return;
+        if (is_abs_zero(this->digits))
+            this->isNegative = product_negative;
+
+        // With one spare digit above the product, the result stays above -10^n, so at most 1 is borrowed past the top
+        const bool subtract = this->isNegative != product_negative;
+        const std::size_t product_size = b.size() + (word != 0 ? 20 : c.size());
+        if (this->digits.size() < product_size + 1)
+            this->digits.resize(product_size + 1);
+
+        std::uint64_t borrow = 0;
+        if (word != 0)
         {
-            return true;
+            borrow = multiply_accumulate_in_place(this->digits, b, word, 0, subtract);
         }
-        if (!this->isNegative && rhs.isNegative)
+        else
         {
-            return false;
+            for (std::size_t j = 0; j < c.size(); j++)
+            {
+                if (c[j] != 0)
+                    borrow += multiply_accumulate_in_place(this->digits, b, c[j], j, subtract);
+            }
         }
 
-        if (this->isNegative)
-            return !is_abs_less_than(this->digits, rhs.digits);
-        return is_abs_less_than(this->digits, rhs.digits);
+        if (borrow != 0)
+        {
+            // The digits hold the result plus 10^n, so the magnitude is their ten's complement
+            std::uint8_t take = 0;
+            for (auto &digit : this->digits)
+            {
+                const std::uint8_t next = digit != 0 || take != 0 ? 1 : 0;
+                digit = static_cast<std::uint8_t>((10 - digit - take) % 10);
+                take = next;
+            }
+            this->isNegative = !this->isNegative;
+        }
+
+        remove_leading_zeros(this->digits);
+        if (is_abs_zero(this->digits))
+            this->isNegative = false;
     }
 
     /**
-     * @brief Less Than or Equal Operator: Check if the current number is less than or equal to another number
-     * @param rhs The number to be compared with
-     * @return True iff the current number is less than or equal to <rhs>
+     * @brief From this n on, factorials are built from their prime factorization instead of multiplying 2 to n
      */
-    bool operator<=(const bigint &rhs) const
+    static constexpr std::uint64_t factorial_prime_threshold = 64;
+
+    /**
+     * @brief Multiply a list of numbers with a balanced product tree, so both factors of every multiplication have about the same size
+     * @param factors Numbers to be multiplied, consumed by the tree
+     * @return The product, 1 for an empty list
+     */
+    static constexpr bigint product_tree(std::vector<bigint> &factors)
     {
-        if (*this == rhs)
-            return true;
-        return *this < rhs;
+        if (factors.empty())
+            return bigint(1);
+
+        // Multiply neighbours level by level until a single number is left
+        while (factors.size() > 1)
+        {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i + 1 < factors.size(); i += 2)
+                factors[count++] = factors[i] * factors[i + 1];
+            if (factors.size() % 2 == 1)
+                factors[count++] = std::move(factors.back());
+            factors.resize(count);
+        }
+        return std::move(factors.front());
     }
 
     /**
-     * @brief Greater Than Operator: Check if the current number is greater than another number
-     * @param rhs The number to be compared with
-     * @return True iff the current number is greater than <rhs>
+     * @brief Multiply a list of word-sized numbers. Neighbouring words are packed into one word as long as the product fits,
+     * so the product tree starts with far fewer leaves.
+     * @param words Numbers to be multiplied, each below 2^63
+     * @return The product, 1 for an empty list
      */
-    bool operator>(const bigint &rhs) const
+    static constexpr bigint word_product(std::span<const std::uint64_t> words)
     {
-        return !(*this <= rhs);
+        constexpr std::uint64_t word_limit = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+
+        std::vector<bigint> leaves;
+        std::uint64_t packed = 1;
+        for (std::uint64_t word : words)
+        {
+            if (word == 0)
+                return bigint();
+            if (packed > word_limit / word)
+            {
+                leaves.emplace_back(static_cast<std::int64_t>(packed));
+                packed = 1;
+            }
+            packed *= word;
+        }
+        if (packed != 1 || leaves.empty())
+            leaves.emplace_back(static_cast<std::int64_t>(packed));
+        return product_tree(leaves);
     }
 
     /**
-     * @brief Greater Than or Equal Operator: Check if the current number is greater than or equal to another number
-     * @param rhs The number to be compared with
-     * @return True iff the current number is greater than or equal to <rhs>
+     * @brief Find all primes up to <n> with the sieve of Eratosthenes
+     * @param n Upper bound, inclusive
+     * @return The primes in increasing order
      */
-    bool operator>=(const bigint &rhs) const
+    static constexpr std::vector<std::uint64_t> primes_up_to(std::uint64_t n)
     {
-        return !(*this < rhs);
+        std::vector<std::uint64_t> primes;
+        if (n < 2)
+            return primes;
+
+        // Reference: https://en.wikipedia.org/wiki/Sieve_of_Eratosthenes
+        std::vector<bool> composite(n + 1, false);
+        for (std::uint64_t i = 2; i <= n; i++)
+        {
+            if (composite[i])
+                continue;
+            primes.push_back(i);
+            for (std::uint64_t j = i * i; j <= n; j += i)
+                composite[j] = true;
+        }
+        return primes;
     }
 
     /**
-     * @brief Insertion Operator: Send the number to the output stream
-     * @param stream Output stream to send the number
-     * @param num Number to be sent
-     * @return The output stream after sending the number
+     * @brief Exponent of the prime <p> in n!, by Legendre's formula
+     * @param n The number whose factorial is factorized
+     * @param p The prime
+     * @return The sum of n / p^i over all i >= 1
      */
-    friend std::ostream &operator<<(std::ostream &stream, const bigint &num)
+    static constexpr std::uint64_t legendre_exponent(std::uint64_t n, std::uint64_t p)
     {
-        // Reference: https://stackoverflow.com/questions/476272/how-can-i-properly-overload-the-operator-for-an-ostream
-        if (num.isNegative)
-            stream << '-';
+        std::uint64_t exponent = 0;
+        while (n >= p)
+        {
+            n /= p;
+            exponent += n;
+        }
+        return exponent;
+    }
 
-        // Reference: https://stackoverflow.com/questions/3610933/iterating-c-vector-from-the-end-to-the-beginning
-        for (auto &digit : num.digits | std::views::reverse)
-            stream << static_cast<char>(digit + '0');
+    /**
+     * @brief Build a number from its prime factorization. The product of all primes whose exponent has bit i set is
+     * computed with a product tree, and the partial results are combined by squaring from the top bit down.
+     * @param primes The primes
+     * @param exponents Exponent of each prime
+     * @return The product of primes[i]^exponents[i]
+     */
+    static constexpr bigint from_prime_powers(std::span<const std::uint64_t> primes, std::span<const std::uint64_t> exponents)
+    {
+        std::uint64_t max_exponent = 0;
+        for (std::uint64_t exponent : exponents)
+            max_exponent = std::max(max_exponent, exponent);
 
-        return stream;
+        bigint result(1);
+        std::vector<std::uint64_t> selected;
+        for (int bit = std::bit_width(max_exponent) - 1; bit >= 0; bit--)
+        {
+            result *= result;
+
+            selected.clear();
+            for (std::size_t i = 0; i < primes.size(); i++)
+            {
+                if ((exponents[i] >> bit) & 1)
+                    selected.push_back(primes[i]);
+            }
+            if (!selected.empty())
+                result *= word_product(selected);
+        }
+        return result;
     }
-};
+
+    /**
+     * @brief Digits of an integer literal, computed at compile time
+     */
+    template <std::size_t N>
+    struct literal_image
+    {
+        std::array<std::uint8_t, N> digits{};
+        std::size_t size = 0;
+    };
+
+    /**
+     * @brief Validate the chars of an integer literal and turn them into digits at compile time
+     * @return The digits in the order of <digits>, without leading zeros
+     */
+    template <char... Chars>
+    static consteval literal_image<sizeof...(Chars)> parse_literal()
+    {
+        constexpr std::array<char, sizeof...(Chars)> text{Chars...};
+        literal_image<sizeof...(Chars)> image;
+
+        for (std::size_t i = text.size(); i > 0; i--)
+        {
+            // Digit separators, e.g. 1'000'000_big
+            if (text[i - 1] == '\'')
+                continue;
+            if (text[i - 1] < '0' || text[i - 1] > '9')
+                throw std::invalid_argument("Error: Literal contains non-digit char.");
+            image.digits[image.size++] = static_cast<std::uint8_t>(text[i - 1] - '0');
+        }
+
+        while (image.size > 1 && image.digits[image.size - 1] == 0)
+            image.size--;
+        return image;
+    }
+
+    /**
+     * @brief Digits constructor: Copy digits that are already validated and free of leading zeros
+     * @param image Digits in the order of <digits>
+     */
+    constexpr explicit bigint(std::span<const std::uint8_t> image)
+        : isNegative(false), digits(scratch_pool::acquire(image.size()))
+    {
+        std::copy(image.begin(), image.end(), this->digits.begin());
+    }
+
+    template <char... Chars>
+    friend constexpr bigint operator""_big();
+
+public:
+    /**
+     * @brief Payload encodings of the binary format
+     */
+    enum class binary_encoding : std::uint8_t
+    {
+        limbs,  // Compact: 64-bit limbs of 19 decimal digits each
+        digits, // Digit image: one byte per digit exactly as stored in memory, so a mapped copy can be used in place
+    };
+
+    /**
+     * @brief What the conversions to native integers do when the number does not fit
+     */
+    enum class conversion_mode : std::uint8_t
+    {
+        checked,  // Throw std::overflow_error
+        truncate, // Keep the low 64 bits of the two's complement, like a cast between built-in integers
+    };
+
+private:
+    /*
+     * Binary format (version 1): a 16-byte header followed by the payload.
+     *   bytes 0-3   magic "BGNT"
+     *   byte  4     format version
+     *   byte  5     flags, bit 0 is the sign, bit 1 selects the digit image encoding
+     *   bytes 6-7   reserved, zero
+     *   bytes 8-15  number of limbs or digits in the payload, little-endian 64-bit
+     * Each limb is a little-endian 64-bit word holding 19 decimal digits, least significant limb first. Zero has no limbs.
+     * The digit image stores the digits least significant first, with a single 0 for zero.
+     */
+    static constexpr std::size_t limb_digits = 19;
+    static constexpr std::uint64_t limb_base = 10000000000000000000ULL;
+    static constexpr std::array<unsigned char, 4> serial_magic{'B', 'G', 'N', 'T'};
+    static constexpr std::uint8_t serial_version = 1;
+    static constexpr std::uint8_t serial_flag_negative = 1;
+    static constexpr std::uint8_t serial_flag_digits = 2;
+    static constexpr std::size_t serial_header_size = 16;
+
+    friend class bigint_view;
+    friend class bigint_parser;
+    friend class bigint_accumulator;
+    friend class bigint_tuner;
+    friend class bigdecimal;
+    friend class bigint_sieve;
+    friend class bigint_parallel;
+    friend class bigint_remainder_tree;
+    friend class shared_bigint;
+
+    /**
+     * @brief Number of 19-digit limbs needed to store the magnitude
+     * @return The limb count, 0 for zero
+     */
+    std::size_t limb_count() const
+    {
+        if (is_abs_zero(this->digits))
+            return 0;
+        return (this->digits.size() + limb_digits - 1) / limb_digits;
+    }
+
+    /**
+     * @brief Pack 19 digits of the magnitude into one limb
+     * @param index Index of the limb, 0 is the least significant one
+     * @return The value of the limb, less than 10^19
+     */
+    std::uint64_t limb_at(std::size_t index) const
+    {
+        const std::size_t begin = index * limb_digits;
+        const std::size_t end = std::min(begin + limb_digits, this->digits.size());
+
+        std::uint64_t limb = 0;
+        for (std::size_t i = end; i > begin; i--)
+            limb = limb * 10 + this->digits[i - 1];
+        return limb;
+    }
+
+    /**
+     * @brief Unpack limbs into a vector of digits. The buffer grows as the limbs arrive, so a count read from an untrusted
+     * header never sizes an allocation on its own.
+     * @param count Number of limbs
+     * @param limb Callable returning the limb at a given index
+     * @return A vector of digits without leading zeros
+     */
+    template <typename LimbSource>
+    static std::vector<std::uint8_t> limbs_to_digits(std::size_t count, LimbSource limb)
+    {
+        if (count == 0)
+            return scratch_pool::acquire(1);
+
+        std::vector<std::uint8_t> result = scratch_pool::acquire(0);
+        std::uint64_t top = 0;
+        for (std::size_t j = 0; j < count; j++)
+        {
+            std::uint64_t value = limb(j);
+            top = value;
+            if (value >= limb_base)
+                throw std::invalid_argument("Error: Limb out of range in binary bigint.");
+
+            result.resize(result.size() + limb_digits);
+            for (std::size_t k = result.size() - limb_digits; k < result.size(); k++)
+            {
+                result[k] = static_cast<std::uint8_t>(value % 10);
+                value /= 10;
+            }
+        }
+        // Zero has no limbs, so a zero top limb is not canonical
+        if (top == 0)
+            throw std::invalid_argument("Error: Top limb of binary bigint is zero.");
+
+        remove_leading_zeros(result);
+        return result;
+    }
+
+    /**
+     * @brief Store a 64-bit word in little-endian byte order
+     * @param out Destination of the 8 bytes
+     * @param value Word to be stored
+     */
+    static void store_u64_le(std::byte *out, std::uint64_t value)
+    {
+        for (std::size_t i = 0; i < 8; i++)
+            out[i] = static_cast<std::byte>(value >> (8 * i));
+    }
+
+    /**
+     * @brief Load a 64-bit word stored in little-endian byte order
+     * @param in Source of the 8 bytes, no alignment required
+     * @return The word
+     */
+    static std::uint64_t load_u64_le(const std::byte *in)
+    {
+        std::uint64_t value = 0;
+        for (std::size_t i = 8; i > 0; i--)
+            value = (value << 8) | std::to_integer<std::uint64_t>(in[i - 1]);
+        return value;
+    }
+
+    /**
+     * @brief Write the 16-byte header of the binary format
+     * @param out Destination of the header
+     * @param encoding Encoding of the payload following the header
+     */
+    void write_serial_header(std::byte *out, binary_encoding encoding) const
+    {
+        const bool image = encoding == binary_encoding::digits;
+        for (std::size_t i = 0; i < serial_magic.size(); i++)
+            out[i] = static_cast<std::byte>(serial_magic[i]);
+        out[4] = static_cast<std::byte>(serial_version);
+        out[5] = static_cast<std::byte>((this->isNegative ? serial_flag_negative : 0) | (image ? serial_flag_digits : 0));
+        out[6] = std::byte{0};
+        out[7] = std::byte{0};
+        store_u64_le(out + 8, image ? this->digits.size() : limb_count());
+    }
+
+    /**
+     * @brief Validate the 16-byte header of the binary format
+     * @param in Source of the header
+     * @return The number of limbs or digits following the header
+     */
+    static std::uint64_t read_serial_header(const std::byte *in)
+    {
+        for (std::size_t i = 0; i < serial_magic.size(); i++)
+        {
+            if (in[i] != static_cast<std::byte>(serial_magic[i]))
+                throw std::invalid_argument("Error: Not a binary bigint.");
+        }
+        if (in[4] != static_cast<std::byte>(serial_version))
+            throw std::invalid_argument("Error: Unsupported binary bigint version.");
+        return load_u64_le(in + 8);
+    }
+
+    /**
+     * @brief Fill a range of digits with uniform random digits, 18 digits per word drawn
+     * @param digits The digits to be filled
+     * @param urbg Source of random bits
+     */
+    template <std::uniform_random_bit_generator URBG>
+    static void fill_random_digits(std::span<std::uint8_t> digits, URBG &urbg)
+    {
+        std::uniform_int_distribution<std::uint64_t> word(0, 999999999999999999ULL);
+        for (std::size_t i = 0; i < digits.size(); i += 18)
+        {
+            std::uint64_t value = word(urbg);
+            for (std::size_t j = i; j < std::min(digits.size(), i + 18); j++, value /= 10)
+                digits[j] = static_cast<std::uint8_t>(value % 10);
+        }
+    }
+
+    /**
+     * @brief Multiply the absolute value of <num> by a small factor and add a small addend in one pass
+     * @param num Vector of digits to be updated in place
+     * @param factor Factor, at most 2^32
+     * @param addend Addend, at most 2^32
+     */
+    static void multiply_small_add_in_place(std::vector<std::uint8_t> &num, std::uint64_t factor, std::uint64_t addend)
+    {
+        const bigint_instrumentation::scope probe(bigint_kernel::multiply_word, num.size());
+        std::uint64_t carry = addend;
+        for (auto &digit : num)
+        {
+            const std::uint64_t curr = digit * factor + carry;
+            digit = static_cast<std::uint8_t>(curr % 10);
+            carry = curr / 10;
+        }
+
+        while (carry != 0)
+        {
+            num.push_back(static_cast<std::uint8_t>(carry % 10));
+            carry /= 10;
+        }
+        remove_leading_zeros(num);
+    }
+
+    /**
+     * @brief Divide the absolute value of <num> by a small divisor in place
+     * @param num Vector of digits to be divided
+     * @param divisor Non-zero divisor, at most 2^32
+     * @return The remainder of the division
+     */
+    static std::uint64_t divide_small_in_place(std::vector<std::uint8_t> &num, std::uint64_t divisor)
+    {
+        const bigint_instrumentation::scope probe(bigint_kernel::divide_word, num.size());
+        std::uint64_t remainder = 0;
+        for (std::size_t i = num.size(); i > 0; i--)
+        {
+            const std::uint64_t curr = remainder * 10 + num[i - 1];
+            num[i - 1] = static_cast<std::uint8_t>(curr / divisor);
+            remainder = curr % divisor;
+        }
+
+        remove_leading_zeros(num);
+        return remainder;
+    }
+
+    /**
+     * @brief Check that a base is supported by the radix conversions
+     * @param base The base
+     */
+    static void check_radix(int base)
+    {
+        if (base < 2 || base > 36)
+            throw std::invalid_argument("Error: Base must be between 2 and 36.");
+    }
+
+    /**
+     * @brief Value of a char in bases up to 36, where a-z and A-Z stand for 10 to 35
+     * @param c The char
+     * @return The value, 36 if the char is not a digit in any base
+     */
+    static constexpr int radix_digit(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'z')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'Z')
+            return c - 'A' + 10;
+        return 36;
+    }
+
+    /**
+     * @brief Largest power of a base that fits the word helpers, so a whole chunk of chars is converted per pass over the digits
+     * @param base The base
+     * @param chunk Receives the number of chars in a chunk
+     * @return base^chunk
+     */
+    static std::uint64_t radix_word(int base, std::size_t &chunk)
+    {
+        std::uint64_t word = 1;
+        chunk = 0;
+        while (word * static_cast<std::uint64_t>(base) <= (std::uint64_t{1} << 32))
+        {
+            word *= static_cast<std::uint64_t>(base);
+            chunk++;
+        }
+        return word;
+    }
+
+    /**
+     * @brief Write the magnitude in a base other than 10 backwards from the end of a buffer, with leading zeros if the
+     * buffer is longer than the number. Each pass of word division over a copy of the digits gives a whole chunk of chars.
+     * @param first Start of the buffer, long enough for every digit in the base
+     * @param last End of the buffer
+     * @param base The base, from 2 to 36
+     */
+    void write_radix_chars(char *first, char *last, int base) const
+    {
+        constexpr char symbols[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+        std::size_t chunk = 0;
+        const std::uint64_t word = radix_word(base, chunk);
+        std::vector<std::uint8_t> work = scratch_pool::acquire(this->digits.size());
+        std::copy(this->digits.begin(), this->digits.end(), work.begin());
+        bigint_control::stage stage;
+        while (last != first)
+        {
+            std::uint64_t part = divide_small_in_place(work, word);
+            for (std::size_t i = 0; i < chunk && last != first; i++)
+            {
+                *--last = symbols[part % static_cast<std::uint64_t>(base)];
+                part /= static_cast<std::uint64_t>(base);
+            }
+            stage.step(is_abs_zero(work) ? this->digits.size() : this->digits.size() - work.size(), this->digits.size());
+        }
+        scratch_pool::release(std::move(work));
+    }
+
+    /**
+     * @brief Magnitude modulo 2^64, computed with wrapping word arithmetic in one pass over the digits
+     * @param fits Receives true iff the magnitude is below 2^64
+     * @return The low 64 bits of the magnitude
+     */
+    constexpr std::uint64_t magnitude_word(bool &fits) const
+    {
+        constexpr std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+        std::uint64_t word = 0;
+        fits = this->digits.size() <= 20; // 2^64 has 20 digits
+        for (std::size_t i = this->digits.size(); i > 0; i--)
+        {
+            if (fits && word > (max - this->digits[i - 1]) / 10)
+                fits = false;
+            word = word * 10 + this->digits[i - 1];
+        }
+        return word;
+    }
+
+    /**
+     * @brief Split the magnitude into a leading word and a power of ten, the basis of the floating point estimates
+     * @param decimal_exponent Receives the number of digits below the leading word
+     * @return The top 19 digits, or all digits of a shorter number
+     */
+    constexpr std::uint64_t leading_word(std::int64_t &decimal_exponent) const
+    {
+        const std::size_t count = std::min(this->digits.size(), limb_digits);
+        std::uint64_t word = 0;
+        for (std::size_t i = 0; i < count; i++)
+            word = word * 10 + this->digits[this->digits.size() - 1 - i];
+        decimal_exponent = static_cast<std::int64_t>(this->digits.size() - count);
+        return word;
+    }
+
+public:
+    /**
+     * @brief Default constructor: Initialize the number to zero
+     */
+    explicit constexpr bigint()
+    {
+        isNegative = false;
+        digits.push_back(0);
+    }
+
+    /**
+     * @brief Int64 constructor: Initialize the number to the given integer
+     * @param num Integer to be converted to bigint
+     */
+    explicit constexpr bigint(std::int64_t num)
+    {
+        // Handle overflow when converting to abs: the magnitude of the minimum of int64_t only fits in uint64_t
+        // Reference: https://stackoverflow.com/questions/16033201/smallest-values-for-int8-t-and-int64-t
+        isNegative = num < 0;
+        std::uint64_t magnitude = isNegative ? 0 - static_cast<std::uint64_t>(num) : static_cast<std::uint64_t>(num);
+        if (magnitude == 0)
+        {
+            digits.push_back(0);
+        }
+        else
+        {
+            while (magnitude != 0)
+            {
+                digits.push_back(static_cast<std::uint8_t>(magnitude % 10));
+                magnitude /= 10;
+            }
+        }
+    }
+
+    /**
+     * @brief String constructor: Initialize the number to the given string. A view is taken, so a substring of a larger
+     * buffer is parsed without copying it.
+     * @param str String to be converted to bigint
+     */
+    explicit constexpr bigint(std::string_view str)
+    {
+        if (str.empty())
+            throw std::invalid_argument("Empty string is not permitted");
+        str_to_bigint(str);
+    }
+
+    /**
+     * @brief Radix string constructor: Initialize the number to a string of digits in the given base.
+     * Digits above 9 are the letters a-z in either case. Base 10 is parsed like the string constructor. In other bases,
+     * every pass over the digits multiplies in a whole chunk of chars.
+     * @param str String to be converted to bigint, with an optional sign and without a base prefix
+     * @param base The base, from 2 to 36
+     */
+    bigint(std::string_view str, int base)
+    {
+        check_radix(base);
+        if (str.empty())
+            throw std::invalid_argument("Empty string is not permitted");
+        if (base == 10)
+        {
+            str_to_bigint(str);
+            return;
+        }
+
+        const bigint_instrumentation::scope probe(bigint_kernel::parse, str.size());
+
+        const bool negative = str[0] == '-';
+        if (str[0] == '-' || str[0] == '+')
+        {
+            if (str.size() == 1)
+                throw std::invalid_argument("Error: String contains only a sign char.");
+            str.remove_prefix(1);
+        }
+        for (char c : str)
+        {
+            if (radix_digit(c) >= base)
+                throw std::invalid_argument("Error: String contains non-digit char.");
+        }
+
+        // Each chunk of chars is folded into one word, then added with a single pass over the digits
+        std::size_t chunk = 0;
+        radix_word(base, chunk);
+        this->digits = scratch_pool::acquire(1);
+        bigint_control::stage stage;
+        for (std::size_t i = 0; i < str.size(); i += chunk)
+        {
+            std::uint64_t word = 0;
+            std::uint64_t factor = 1;
+            for (std::size_t j = i; j < std::min(str.size(), i + chunk); j++)
+            {
+                word = word * static_cast<std::uint64_t>(base) + static_cast<std::uint64_t>(radix_digit(str[j]));
+                factor *= static_cast<std::uint64_t>(base);
+            }
+            multiply_small_add_in_place(this->digits, factor, word);
+            stage.step(std::min(str.size(), i + chunk), str.size());
+        }
+        this->isNegative = negative && !is_abs_zero(this->digits);
+    }
+
+    /**
+     * @brief Copy constructor: Copy the digits into a buffer borrowed from the scratch pool
+     * @param other Number to be copied
+     */
+    constexpr bigint(const bigint &other) : isNegative(other.isNegative), digits(scratch_pool::acquire(other.digits.size()))
+    {
+        std::copy(other.digits.begin(), other.digits.end(), this->digits.begin());
+    }
+
+    /**
+     * @brief Move constructor: Take over the digits of another number
+     * @param other Number to be moved from
+     */
+    constexpr bigint(bigint &&other) noexcept = default;
+
+    /**
+     * @brief Copy assignment operator: Reuse the current buffer if it is large enough
+     * @param other Number to be copied
+     * @return The current number after assignment
+     */
+    constexpr bigint &operator=(const bigint &other) = default;
+
+    /**
+     * @brief Move assignment operator: Take over the digits of another number and recycle the current buffer
+     * @param other Number to be moved from
+     * @return The current number after assignment
+     */
+    constexpr bigint &operator=(bigint &&other) noexcept
+    {
+        if (this != &other)
+        {
+            this->isNegative = other.isNegative;
+            replace_digits(std::move(other.digits));
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destructor: Return the digits buffer to the scratch pool of the current thread
+     */
+    constexpr ~bigint()
+    {
+        scratch_pool::release(std::move(this->digits));
+    }
+
+    /**
+     * @brief Negation operator: transform the current number to its negation
+     * @return The negation of the current number
+     */
+    constexpr bigint operator-() const
+    {
+        // Reference: https://www.geeksforgeeks.org/shallow-copy-and-deep-copy-in-c/
+        bigint negative = *this;
+
+        // Ignore negative zero to avoid unexpected behavior
+        if (!(negative.digits.size() == 1 && negative.digits[0] == 0))
+        {
+            negative.isNegative = !negative.isNegative;
+        }
+
+        return negative;
+    }
+
+    /**
+     * @brief Increment operator (prefix): Add 1 to the current number
+     * @return The incremented number
+     */
+    constexpr bigint &operator++()
+    {
+        *this += bigint(1);
+        return *this;
+    }
+
+    /**
+     * @brief Increment operator (postfix): Add 1 to the current number
+     * @return The original number before increment
+     */
+    constexpr bigint operator++(int)
+    {
+        bigint temp = *this;
+        *this += bigint(1);
+        return temp;
+    }
+
+    /**
+     * @brief Decrement operator (prefix): Subtract 1 from the current number
+     * @return The decremented number
+     */
+    constexpr bigint &operator--()
+    {
+        *this -= bigint(1);
+        return *this;
+    }
+
+    /**
+     * @brief Decrement operator (postfix): Subtract 1 from the current number
+     * @return The original number before decrement
+     */
+    constexpr bigint operator--(int)
+    {
+        bigint temp = *this;
+        *this -= bigint(1);
+        return temp;
+    }
+
+    /**
+     * @brief Addition Assignment Operator: Add <rhs> to the current number
+     * @param rhs Number to be added to the current number
+     * @return The current number after addition
+     */
+    constexpr bigint &operator+=(const bigint &rhs)
+    {
+        add_signed(rhs.digits, rhs.isNegative);
+        return *this;
+    }
+
+    /**
+     * @brief Subtraction Assignment Operator: Subtract another number from the current number
+     * @param rhs Number to be subtracted from the current number
+     * @return The current number after subtraction
+     */
+    constexpr bigint &operator-=(const bigint &rhs)
+    {
+        // Flip the sign of the operand instead of copying its negation, zero has no sign to flip
+        add_signed(rhs.digits, !rhs.isNegative && !is_abs_zero(rhs.digits));
+        return *this;
+    }
+
+    /**
+     * @brief Multiplication Assignment Operator: Multiply another number to the current number
+     * @param rhs Number to be multiplied to the current number
+     * @return The current number after multiplication
+     */
+    constexpr bigint &operator*=(const bigint &rhs)
+    {
+        multiply_signed(rhs.digits, rhs.isNegative);
+        return *this;
+    }
+
+    /**
+     * @brief Division Assignment Operator: Divide the current number by another number
+     * @param rhs Number to divide the current number by
+     * @return The current number after division
+     */
+    constexpr bigint &operator/=(const bigint &rhs)
+    {
+        divide_signed(rhs.digits, rhs.isNegative);
+        return *this;
+    }
+
+    /**
+     * @brief Modulo Assignment Operator: Replace the current number by the remainder of its division by another number
+     * @param rhs Number to divide the current number by
+     * @return The current number after the operation, with the sign of the dividend
+     */
+    constexpr bigint &operator%=(const bigint &rhs)
+    {
+        modulo_signed(rhs.digits);
+        return *this;
+    }
+
+    /**
+     * @brief Multiply the current number by 10^<n> by inserting <n> zero digits at the low end
+     * @param n Power of ten
+     * @return The current number after the operation
+     */
+    constexpr bigint &multiply_pow10(std::size_t n)
+    {
+        if (n == 0 || is_abs_zero(this->digits))
+            return *this;
+        std::vector<std::uint8_t> result = scratch_pool::acquire(this->digits.size() + n);
+        std::copy(this->digits.begin(), this->digits.end(), result.begin() + static_cast<std::ptrdiff_t>(n));
+        replace_digits(std::move(result));
+        return *this;
+    }
+
+    /**
+     * @brief Replace the current number by its remainder modulo 10^<n> by keeping its <n> lowest digits, with the sign of
+     * the dividend like operator%
+     * @param n Power of ten
+     * @return The current number after the operation
+     */
+    constexpr bigint &modulo_pow10(std::size_t n)
+    {
+        if (n >= this->digits.size())
+            return *this;
+        this->digits.resize(std::max<std::size_t>(n, 1));
+        if (n == 0)
+            this->digits[0] = 0;
+        remove_leading_zeros(this->digits);
+        if (is_abs_zero(this->digits))
+            this->isNegative = false;
+        return *this;
+    }
+
+    /**
+     * @brief Divide the current number by 10^<n> by dropping its <n> lowest digits, truncating toward zero like operator/
+     * @param n Power of ten
+     * @return The current number after the operation
+     */
+    constexpr bigint &divide_pow10(std::size_t n)
+    {
+        if (n == 0)
+            return *this;
+        if (n >= this->digits.size())
+        {
+            replace_digits(scratch_pool::acquire(1));
+            this->isNegative = false;
+            return *this;
+        }
+        std::vector<std::uint8_t> result = scratch_pool::acquire(this->digits.size() - n);
+        std::copy(this->digits.begin() + static_cast<std::ptrdiff_t>(n), this->digits.end(), result.begin());
+        replace_digits(std::move(result));
+        return *this;
+    }
+
+    /**
+     * @brief Addition Assignment Operator: Add a number read through a binary view to the current number
+     * @param rhs View of the number to be added, used in place if it stores digits
+     * @return The current number after addition
+     */
+    bigint &operator+=(const bigint_view &rhs);
+
+    /**
+     * @brief Subtraction Assignment Operator: Subtract a number read through a binary view from the current number
+     * @param rhs View of the number to be subtracted, used in place if it stores digits
+     * @return The current number after subtraction
+     */
+    bigint &operator-=(const bigint_view &rhs);
+
+    /**
+     * @brief Multiplication Assignment Operator: Multiply a number read through a binary view to the current number
+     * @param rhs View of the number to be multiplied, used in place if it stores digits
+     * @return The current number after multiplication
+     */
+    bigint &operator*=(const bigint_view &rhs);
+
+    /**
+     * @brief Division Assignment Operator: Divide the current number by a number read through a binary view
+     * @param rhs View of the number to divide by, used in place if it stores digits
+     * @return The current number after division
+     */
+    bigint &operator/=(const bigint_view &rhs);
+
+    /**
+     * @brief Modulo Assignment Operator: Replace the current number by the remainder of its division by a number read through a binary view
+     * @param rhs View of the number to divide by, used in place if it stores digits
+     * @return The current number after the operation, with the sign of the dividend
+     */
+    bigint &operator%=(const bigint_view &rhs);
+
+    /**
+     * @brief Addition Operator: Add two numbers
+     * @param lhs The first number to be added
+     * @param rhs The second number to be added
+     * @return A new number that is the sum of the two numbers
+     */
+    friend constexpr bigint operator+(bigint lhs, const bigint &rhs)
+    {
+        // Friend functions to allow using compound assignment operators as it will call private parameters.
+        return lhs += rhs;
+    }
+
+    /**
+     * @brief Subtraction Operator: Subtract two numbers
+     * @param lhs The number to be subtracted from
+     * @param rhs THe number to be subtracted
+     * @return A new number that is the difference of the two numbers
+     */
+    friend constexpr bigint operator-(bigint lhs, const bigint &rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    /**
+     * @brief Multiplication Operator: Multiply two numbers
+     * @param lhs The first number to be multiplied
+     * @param rhs The second number to be multiplied
+     * @return A new number that is the product of the two numbers
+     */
+    friend constexpr bigint operator*(bigint lhs, const bigint &rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    /**
+     * @brief Division Operator: Divide two numbers
+     * @param lhs The number to be divided
+     * @param rhs The number to divide by
+     * @return A new number that is the quotient of the two numbers
+     */
+    friend constexpr bigint operator/(bigint lhs, const bigint &rhs)
+    {
+        return lhs /= rhs;
+    }
+
+    /**
+     * @brief Modulo Operator: Remainder of the division of two numbers
+     * @param lhs The number to be divided
+     * @param rhs The number to divide by
+     * @return A new number that is the remainder, with the sign of <lhs>
+     */
+    friend constexpr bigint operator%(bigint lhs, const bigint &rhs)
+    {
+        return lhs %= rhs;
+    }
+
+    /**
+     * @brief Fused multiply-add: Add the product of two numbers to <acc> without a temporary product
+     * @param acc Number to be added to
+     * @param b The first factor
+     * @param c The second factor
+     */
+    friend constexpr void addmul(bigint &acc, const bigint &b, const bigint &c)
+    {
+        // The digits of <acc> are updated while the factors are read, so a factor aliasing <acc> is copied first
+        if (&acc == &b || &acc == &c)
+        {
+            const bigint operand = acc;
+            addmul(acc, &b == &acc ? operand : b, &c == &acc ? operand : c);
+            return;
+        }
+        acc.accumulate_product(b.digits, c.digits, 0, b.isNegative != c.isNegative);
+    }
+
+    /**
+     * @brief Fused multiply-subtract: Subtract the product of two numbers from <acc> without a temporary product
+     * @param acc Number to be subtracted from
+     * @param b The first factor
+     * @param c The second factor
+     */
+    friend constexpr void submul(bigint &acc, const bigint &b, const bigint &c)
+    {
+        // The digits of <acc> are updated while the factors are read, so a factor aliasing <acc> is copied first
+        if (&acc == &b || &acc == &c)
+        {
+            const bigint operand = acc;
+            submul(acc, &b == &acc ? operand : b, &c == &acc ? operand : c);
+            return;
+        }
+        acc.accumulate_product(b.digits, c.digits, 0, b.isNegative == c.isNegative);
+    }
+
+    /**
+     * @brief Fused multiply-add with a word: Add <b> * <c> to <acc> in a single pass over the digits of <b>
+     * @param acc Number to be added to
+     * @param b The first factor
+     * @param c The word-sized second factor
+     */
+    friend constexpr void addmul(bigint &acc, const bigint &b, std::int64_t c)
+    {
+        if (&acc == &b)
+        {
+            const bigint operand = acc;
+            addmul(acc, operand, c);
+            return;
+        }
+        const std::uint64_t word = c < 0 ? 0 - static_cast<std::uint64_t>(c) : static_cast<std::uint64_t>(c);
+        if (word != 0)
+            acc.accumulate_product(b.digits, {}, word, b.isNegative != (c < 0));
+    }
+
+    /**
+     * @brief Fused multiply-subtract with a word: Subtract <b> * <c> from <acc> in a single pass over the digits of <b>
+     * @param acc Number to be subtracted from
+     * @param b The first factor
+     * @param c The word-sized second factor
+     */
+    friend constexpr void submul(bigint &acc, const bigint &b, std::int64_t c)
+    {
+        if (&acc == &b)
+        {
+            const bigint operand = acc;
+            submul(acc, operand, c);
+            return;
+        }
+        const std::uint64_t word = c < 0 ? 0 - static_cast<std::uint64_t>(c) : static_cast<std::uint64_t>(c);
+        if (word != 0)
+            acc.accumulate_product(b.digits, {}, word, b.isNegative == (c < 0));
+    }
+
+    /**
+     * @brief Product of a range of numbers, computed with a balanced product tree
+     * @param range Range of bigint objects or integers
+     * @return The product, 1 for an empty range
+     */
+    template <std::ranges::input_range R>
+    static constexpr bigint product(R &&range)
+    {
+        std::vector<bigint> factors;
+        if constexpr (std::ranges::sized_range<R>)
+            factors.reserve(std::ranges::size(range));
+        for (auto &&factor : range)
+        {
+            if constexpr (std::is_integral_v<std::remove_cvref_t<decltype(factor)>>)
+                factors.emplace_back(static_cast<std::int64_t>(factor));
+            else
+                factors.emplace_back(std::forward<decltype(factor)>(factor));
+        }
+        return product_tree(factors);
+    }
+
+    /**
+     * @brief Factorial n! = 1 * 2 * ... * n. Small factorials multiply packed words with a product tree. From
+     * <factorial_prime_threshold> on, n! is built from its prime factorization, found with Legendre's formula.
+     * @param n The number, must not be negative
+     * @return n!
+     */
+    static constexpr bigint factorial(std::int64_t n)
+    {
+        if (n < 0)
+            throw std::invalid_argument("Error: Factorial of a negative number.");
+
+        const std::uint64_t count = static_cast<std::uint64_t>(n);
+        if (count < factorial_prime_threshold)
+        {
+            std::vector<std::uint64_t> words;
+            for (std::uint64_t i = 2; i <= count; i++)
+                words.push_back(i);
+            return word_product(words);
+        }
+
+        const std::vector<std::uint64_t> primes = primes_up_to(count);
+        std::vector<std::uint64_t> exponents(primes.size());
+        for (std::size_t i = 0; i < primes.size(); i++)
+            exponents[i] = legendre_exponent(count, primes[i]);
+        return from_prime_powers(primes, exponents);
+    }
+
+    /**
+     * @brief Binomial coefficient C(n, k), the number of ways to choose <k> of <n> items. The primes of k! are divided
+     * out of the words n - k + 1 to n, which hold at least as many of each, and the words left are multiplied with a
+     * product tree. So no big division is needed, and the sieve only runs up to the smaller of k and n - k.
+     * @param n The number of items, must not be negative
+     * @param k The number of chosen items
+     * @return C(n, k), 0 if <k> is negative or greater than <n>
+     */
+    static constexpr bigint binomial(std::int64_t n, std::int64_t k)
+    {
+        if (n < 0)
+            throw std::invalid_argument("Error: Binomial coefficient of a negative number.");
+        if (k < 0 || k > n)
+            return bigint();
+
+        const std::uint64_t total = static_cast<std::uint64_t>(n);
+        const std::uint64_t chosen = std::min(static_cast<std::uint64_t>(k), total - static_cast<std::uint64_t>(k));
+
+        // words[i] = n - i, and the multiples of p among them are at i = n % p + j * p
+        std::vector<std::uint64_t> words(chosen);
+        for (std::uint64_t i = 0; i < chosen; i++)
+            words[i] = total - i;
+        for (std::uint64_t p : primes_up_to(chosen))
+        {
+            std::uint64_t exponent = legendre_exponent(chosen, p);
+            for (std::uint64_t i = total % p; exponent > 0; i += p)
+            {
+                while (exponent > 0 && words[i] % p == 0)
+                {
+                    words[i] /= p;
+                    exponent--;
+                }
+            }
+        }
+        return word_product(words);
+    }
+
+    /**
+     * @brief Primorial n#, the product of all primes up to <n>
+     * @param n Upper bound of the primes, inclusive
+     * @return n#, 1 if <n> is less than 2
+     */
+    static constexpr bigint primorial(std::int64_t n)
+    {
+        if (n < 2)
+            return bigint(1);
+        const std::vector<std::uint64_t> primes = primes_up_to(static_cast<std::uint64_t>(n));
+        return word_product(primes);
+    }
+
+    /**
+     * @brief Greatest common divisor with the Euclidean algorithm
+     * @param lhs The first number
+     * @param rhs The second number
+     * @return The non-negative GCD, 0 iff both numbers are 0
+     */
+    static constexpr bigint gcd(const bigint &lhs, const bigint &rhs)
+    {
+        bigint a = lhs;
+        bigint b = rhs;
+        a.isNegative = false;
+        b.isNegative = false;
+        while (!is_abs_zero(b.digits))
+        {
+            a.modulo_signed(b.digits);
+            std::swap(a, b);
+        }
+        return a;
+    }
+
+    /**
+     * @brief Uniform random number with a given number of decimal digits, leading zeros allowed.
+     * Each word of 18 digits is drawn once and split straight into <digits>, without going through a string.
+     * @param count Number of digits
+     * @param urbg Source of random bits
+     * @return A number in [0, 10^count)
+     */
+    template <std::uniform_random_bit_generator URBG>
+    static bigint random_digits(std::size_t count, URBG &urbg)
+    {
+        bigint result;
+        result.replace_digits(scratch_pool::acquire(std::max<std::size_t>(count, 1)));
+        fill_random_digits(std::span<std::uint8_t>(result.digits.data(), count), urbg);
+        remove_leading_zeros(result.digits);
+        return result;
+    }
+
+    /**
+     * @brief Uniform random number of a given number of bits.
+     * Words of 32 random bits are folded in from the most significant one with a single multiply-add pass each, so every
+     * value in the range is exactly as likely and nothing is rejected.
+     * @param bits Number of bits
+     * @param urbg Source of random bits
+     * @return A number in [0, 2^bits)
+     */
+    template <std::uniform_random_bit_generator URBG>
+    static bigint random_bits(std::size_t bits, URBG &urbg)
+    {
+        bigint result;
+        std::uniform_int_distribution<std::uint64_t> word(0, 0xFFFFFFFF);
+        std::size_t remaining = bits;
+        while (remaining > 0)
+        {
+            // The top word carries the bits that do not fill a whole word
+            const std::size_t width = remaining % 32 == 0 ? 32 : remaining % 32;
+            multiply_small_add_in_place(result.digits, std::uint64_t(1) << width, word(urbg) >> (32 - width));
+            remaining -= width;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Uniform random number below a bound.
+     * The top word of up to 18 digits is drawn below or equal to the top word of the bound and the other digits are
+     * drawn freely. Only if the top word equals that of the bound can the number reach the bound, and only then is it
+     * compared and drawn again, so for a bound of more than 18 digits a retry happens with a chance below 10^-17.
+     * @param bound The exclusive upper bound, must be positive
+     * @param urbg Source of random bits
+     * @return A number in [0, bound)
+     */
+    template <std::uniform_random_bit_generator URBG>
+    static bigint random_below(const bigint &bound, URBG &urbg)
+    {
+        if (bound.isNegative || is_abs_zero(bound.digits))
+            throw std::invalid_argument("Error: Bound must be positive.");
+
+        const std::size_t size = bound.digits.size();
+        const std::size_t top = std::min<std::size_t>(size, 18);
+        const std::size_t low = size - top;
+        std::uint64_t top_bound = 0;
+        for (std::size_t i = size; i > low; i--)
+            top_bound = top_bound * 10 + bound.digits[i - 1];
+
+        bigint result;
+        result.replace_digits(scratch_pool::acquire(size));
+        std::uniform_int_distribution<std::uint64_t> top_word(0, top_bound);
+        while (true)
+        {
+            std::uint64_t word = top_word(urbg);
+            const bool at_bound = word == top_bound;
+            for (std::size_t i = low; i < size; i++, word /= 10)
+                result.digits[i] = static_cast<std::uint8_t>(word % 10);
+            fill_random_digits(std::span<std::uint8_t>(result.digits.data(), low), urbg);
+
+            // With the top word at the bound, the low digits have to be below those of the bound
+            if (at_bound)
+            {
+                std::size_t i = low;
+                while (i > 0 && result.digits[i - 1] == bound.digits[i - 1])
+                    i--;
+                if (i == 0 || result.digits[i - 1] > bound.digits[i - 1])
+                    continue;
+            }
+            break;
+        }
+        remove_leading_zeros(result.digits);
+        return result;
+    }
+
+    /**
+     * @brief Equality Operator: Check if two numbers are equal
+     * @param rhs The number to be compared with
+     * @return True iff the two numbers are equal
+     */
+    constexpr bool operator==(const bigint &rhs) const
+    {
+        // Reference: https://learn.microsoft.com/en-us/cpp/cpp/equality-operators-equal-equal-and-exclpt-equal?view=msvc-170
+        // In c++, == compares the value of obj, not the address
+        return this->isNegative == rhs.isNegative && this->digits == rhs.digits;
+    }
+
+    /**
+     * @brief Inequality Operator: Check if two numbers are not equal
+     * @param rhs The number to be compared with
+     * @return True iff the two numbers are not equal
+     */
+    constexpr bool operator!=(const bigint &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @brief Less Than Operator: Check if the current number is less than another number
+     * @param rhs The number to be compared with
+     * @return True iff the current number is less than <rhs>
+     */
+    constexpr bool operator<(const bigint &rhs) const
+    {
+        if (this->isNegative && !rhs.isNegative)
+        {
+            return true;
+        }
+        if (!this->isNegative && rhs.isNegative)
+        {
+            return false;
+        }
+
+        if (this->isNegative)
+            return !is_abs_less_than(this->digits, rhs.digits);
+        return is_abs_less_than(this->digits, rhs.digits);
+    }
+
+    /**
+     * @brief Less Than or Equal Operator: Check if the current number is less than or equal to another number
+     * @param rhs The number to be compared with
+     * @return True iff the current number is less than or equal to <rhs>
+     */
+    constexpr bool operator<=(const bigint &rhs) const
+    {
+        if (*this == rhs)
+            return true;
+        return *this < rhs;
+    }
+
+    /**
+     * @brief Greater Than Operator: Check if the current number is greater than another number
+     * @param rhs The number to be compared with
+     * @return True iff the current number is greater than <rhs>
+     */
+    constexpr bool operator>(const bigint &rhs) const
+    {
+        return !(*this <= rhs);
+    }
+
+    /**
+     * @brief Greater Than or Equal Operator: Check if the current number is greater than or equal to another number
+     * @param rhs The number to be compared with
+     * @return True iff the current number is greater than or equal to <rhs>
+     */
+    constexpr bool operator>=(const bigint &rhs) const
+    {
+        return !(*this < rhs);
+    }
+
+    /**
+     * @brief Hash the number word-at-a-time straight over the stored digits
+     * Only the digits themselves are read, so equal numbers hash equally regardless of the capacity of their buffers.
+     * @return The hash of the number
+     */
+    std::size_t hash() const noexcept
+    {
+        // Multiply-xorshift mixing of 8 digits per step, seeded with the sign and the number of digits
+        constexpr std::uint64_t multiplier = 0xbf58476d1ce4e5b9ULL;
+        const std::size_t size = this->digits.size();
+        std::uint64_t h = ((static_cast<std::uint64_t>(size) << 1) | (this->isNegative ? 1 : 0)) * 0x9e3779b97f4a7c15ULL;
+
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, this->digits.data() + i, 8);
+            h = (h ^ word) * multiplier;
+            h ^= h >> 31;
+        }
+        if (i < size)
+        {
+            std::uint64_t word = 0;
+            std::memcpy(&word, this->digits.data() + i, size - i);
+            h = (h ^ word) * multiplier;
+            h ^= h >> 31;
+        }
+
+        h ^= h >> 30;
+        h *= 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+        return static_cast<std::size_t>(h);
+    }
+
+    /**
+     * @brief Size of the binary representation produced by <serialize>
+     * @param encoding Encoding of the payload
+     * @return Number of bytes
+     */
+    std::size_t serialized_size(binary_encoding encoding = binary_encoding::limbs) const
+    {
+        if (encoding == binary_encoding::digits)
+            return serial_header_size + this->digits.size();
+        return serial_header_size + 8 * limb_count();
+    }
+
+    /**
+     * @brief Write the binary representation into a caller-provided buffer
+     * @param buffer Destination, must hold at least <serialized_size> bytes
+     * @param encoding Encoding of the payload
+     * @return Number of bytes written
+     */
+    std::size_t serialize(std::span<std::byte> buffer, binary_encoding encoding = binary_encoding::limbs) const
+    {
+        const std::size_t size = serialized_size(encoding);
+        if (buffer.size() < size)
+            throw std::length_error("Error: Buffer too small for binary bigint.");
+
+        write_serial_header(buffer.data(), encoding);
+        if (encoding == binary_encoding::digits)
+        {
+            std::copy(this->digits.begin(), this->digits.end(),
+                      reinterpret_cast<std::uint8_t *>(buffer.data() + serial_header_size));
+            return size;
+        }
+
+        for (std::size_t j = 0; j < limb_count(); j++)
+            store_u64_le(buffer.data() + serial_header_size + 8 * j, limb_at(j));
+        return size;
+    }
+
+    /**
+     * @brief Write the binary representation to an output stream in fixed-size chunks
+     * @param stream Output stream to write to
+     * @param encoding Encoding of the payload
+     */
+    void serialize(std::ostream &stream, binary_encoding encoding = binary_encoding::limbs) const
+    {
+        std::array<std::byte, 4096> chunk{};
+        write_serial_header(chunk.data(), encoding);
+        std::size_t used = serial_header_size;
+
+        if (encoding == binary_encoding::digits)
+        {
+            // The digit image is the in-memory representation, so it goes to the stream without a staging copy
+            stream.write(reinterpret_cast<const char *>(chunk.data()), static_cast<std::streamsize>(used));
+            stream.write(reinterpret_cast<const char *>(this->digits.data()),
+                         static_cast<std::streamsize>(this->digits.size()));
+            return;
+        }
+
+        const std::size_t count = limb_count();
+        for (std::size_t j = 0; j < count; j++)
+        {
+            if (used == chunk.size())
+            {
+                stream.write(reinterpret_cast<const char *>(chunk.data()), static_cast<std::streamsize>(used));
+                used = 0;
+            }
+            store_u64_le(chunk.data() + used, limb_at(j));
+            used += 8;
+        }
+        stream.write(reinterpret_cast<const char *>(chunk.data()), static_cast<std::streamsize>(used));
+    }
+
+    /**
+     * @brief Read a number from its binary representation
+     * @param buffer Bytes starting with the header
+     * @return The number stored in the buffer
+     */
+    static bigint deserialize(std::span<const std::byte> buffer);
+
+    /**
+     * @brief Read a number from its binary representation in an input stream, in fixed-size chunks
+     * @param stream Input stream positioned at the header
+     * @return The number read from the stream
+     */
+    static bigint deserialize(std::istream &stream)
+    {
+        std::array<std::byte, 4096> chunk{};
+        if (!stream.read(reinterpret_cast<char *>(chunk.data()), static_cast<std::streamsize>(serial_header_size)))
+            throw std::invalid_argument("Error: Truncated binary bigint.");
+
+        const std::uint64_t count = read_serial_header(chunk.data());
+        const std::uint8_t flags = std::to_integer<std::uint8_t>(chunk[5]);
+
+        bigint result;
+        if ((flags & serial_flag_digits) != 0)
+        {
+            if (count == 0)
+                throw std::invalid_argument("Error: Empty digit image in binary bigint.");
+
+            // The image grows chunk by chunk as it is read, so the header count never sizes an allocation on its own
+            std::vector<std::uint8_t> image = scratch_pool::acquire(0);
+            for (std::uint64_t remaining = count; remaining != 0;)
+            {
+                const std::size_t begin = image.size();
+                const std::size_t length = static_cast<std::size_t>(std::min<std::uint64_t>(chunk.size(), remaining));
+                image.resize(begin + length);
+                if (!stream.read(reinterpret_cast<char *>(image.data() + begin), static_cast<std::streamsize>(length)))
+                    throw std::invalid_argument("Error: Truncated binary bigint.");
+                if (std::any_of(image.begin() + begin, image.end(), [](std::uint8_t digit) { return digit > 9; }))
+                    throw std::invalid_argument("Error: Digit out of range in binary bigint.");
+                remaining -= length;
+            }
+
+            remove_leading_zeros(image);
+            result.replace_digits(std::move(image));
+        }
+        else
+        {
+            // Refill the chunk whenever all of its limbs have been unpacked
+            std::uint64_t remaining = count;
+            std::size_t offset = 0;
+            std::size_t available = 0;
+            result.replace_digits(limbs_to_digits(count, [&](std::size_t) {
+                if (offset == available)
+                {
+                    available = 8 * static_cast<std::size_t>(std::min<std::uint64_t>(chunk.size() / 8, remaining));
+                    if (!stream.read(reinterpret_cast<char *>(chunk.data()), static_cast<std::streamsize>(available)))
+                        throw std::invalid_argument("Error: Truncated binary bigint.");
+                    remaining -= available / 8;
+                    offset = 0;
+                }
+                offset += 8;
+                return load_u64_le(chunk.data() + offset - 8);
+            }));
+        }
+        result.isNegative = (flags & serial_flag_negative) != 0 && !is_abs_zero(result.digits);
+        return result;
+    }
+
+    /**
+     * @brief Import a magnitude from raw bytes, in the spirit of mpz_import
+     * @param bytes Bytes of the magnitude
+     * @param order Byte order of <bytes>, most significant byte first by default
+     * @return The non-negative number represented by the bytes
+     */
+    static bigint from_bytes(std::span<const std::byte> bytes, std::endian order = std::endian::big)
+    {
+        bigint result;
+        // Four bytes per pass over the digits
+        std::uint64_t word = 0;
+        std::uint64_t factor = 1;
+        for (std::size_t i = 0; i < bytes.size(); i++)
+        {
+            const std::byte byte = order == std::endian::big ? bytes[i] : bytes[bytes.size() - 1 - i];
+            word = (word << 8) | std::to_integer<std::uint64_t>(byte);
+            factor <<= 8;
+            if (factor == (std::uint64_t{1} << 32) || i + 1 == bytes.size())
+            {
+                multiply_small_add_in_place(result.digits, factor, word);
+                word = 0;
+                factor = 1;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Export the magnitude as raw bytes without leading zero bytes, in the spirit of mpz_export
+     * @param order Byte order of the result, most significant byte first by default
+     * @return The bytes of the magnitude, empty for zero
+     */
+    std::vector<std::byte> to_bytes(std::endian order = std::endian::big) const
+    {
+        std::vector<std::byte> bytes;
+        std::vector<std::uint8_t> work = scratch_pool::acquire(this->digits.size());
+        std::copy(this->digits.begin(), this->digits.end(), work.begin());
+
+        // Four bytes per pass over the digits, least significant first
+        while (!is_abs_zero(work))
+        {
+            const std::uint64_t word = divide_small_in_place(work, std::uint64_t{1} << 32);
+            for (std::size_t i = 0; i < 4; i++)
+                bytes.push_back(static_cast<std::byte>(word >> (8 * i)));
+        }
+        scratch_pool::release(std::move(work));
+
+        while (!bytes.empty() && bytes.back() == std::byte{0})
+            bytes.pop_back();
+        if (order == std::endian::big)
+            std::reverse(bytes.begin(), bytes.end());
+        return bytes;
+    }
+
+    /**
+     * @brief Convert the number to a string of digits in the given base, with the letters a-z for digits above 9.
+     * Base 10 writes 8 digits per step. Other bases divide by the largest power of the base that fits a word, so every
+     * pass over the digits gives a whole chunk of chars.
+     * @param base The base, from 2 to 36
+     * @return The digits with a leading '-' for negative numbers, without a base prefix
+     */
+    std::string to_string(int base = 10) const
+    {
+        const bigint_instrumentation::scope probe(bigint_kernel::format, this->digits.size());
+        check_radix(base);
+
+        // The size estimate of other bases may be one too large, which leaves a single leading zero to drop
+        const std::size_t sign = this->isNegative ? 1 : 0;
+        std::string result(sign + size_in_base(base), '-');
+        if (base == 10)
+        {
+            write_digit_chars(this->digits, result.data() + sign);
+            return result;
+        }
+        write_radix_chars(result.data() + sign, result.data() + result.size(), base);
+        if (result.size() > sign + 1 && result[sign] == '0')
+            result.erase(sign, 1);
+        return result;
+    }
+
+    /**
+     * @brief Exact number of chars written by <to_string> and <to_chars>. It is a count of <digits> in base 10. Other
+     * bases check the size estimate against a power of the base, which costs less than the conversion itself.
+     * @param base The base, from 2 to 36
+     * @return Number of chars, including the sign
+     */
+    std::size_t formatted_size(int base = 10) const
+    {
+        const std::size_t sign = this->isNegative ? 1 : 0;
+        std::size_t size = size_in_base(base);
+        bool fits = base == 10;
+        if (!fits)
+            magnitude_word(fits);
+        if (!fits)
+        {
+            // The estimate is exact or one too large, so the number has size - 1 digits iff it is below base^(size - 1)
+            bigint power(1);
+            bigint square(base);
+            for (std::size_t exponent = size - 1; exponent != 0; exponent >>= 1)
+            {
+                if (exponent & 1)
+                    power *= square;
+                if (exponent > 1)
+                    square *= square;
+            }
+            if (is_abs_less_than(this->digits, power.digits))
+                size--;
+        }
+        return sign + size;
+    }
+
+    /**
+     * @brief Check if the number fits in an int64_t
+     * @return True iff the number is in [-2^63, 2^63)
+     */
+    constexpr bool fits_int64() const
+    {
+        bool fits = false;
+        const std::uint64_t word = magnitude_word(fits);
+        const std::uint64_t limit = std::uint64_t{1} << 63;
+        return fits && (word < limit || (this->isNegative && word == limit));
+    }
+
+    /**
+     * @brief Check if the number fits in a uint64_t
+     * @return True iff the number is in [0, 2^64)
+     */
+    constexpr bool fits_uint64() const
+    {
+        bool fits = false;
+        magnitude_word(fits);
+        return fits && !this->isNegative;
+    }
+
+    /**
+     * @brief Convert the number to an int64_t
+     * @param mode Throw if the number does not fit, or keep the low 64 bits of its two's complement
+     * @return The number as int64_t
+     */
+    constexpr std::int64_t to_int64(conversion_mode mode = conversion_mode::checked) const
+    {
+        if (mode == conversion_mode::checked && !fits_int64())
+            throw std::overflow_error("Error: bigint does not fit in int64_t.");
+        bool fits = false;
+        const std::uint64_t word = magnitude_word(fits);
+        return static_cast<std::int64_t>(this->isNegative ? 0 - word : word);
+    }
+
+    /**
+     * @brief Convert the number to a uint64_t
+     * @param mode Throw if the number does not fit, or keep the low 64 bits of its two's complement
+     * @return The number as uint64_t
+     */
+    constexpr std::uint64_t to_uint64(conversion_mode mode = conversion_mode::checked) const
+    {
+        bool fits = false;
+        const std::uint64_t word = magnitude_word(fits);
+        if (mode == conversion_mode::checked && (!fits || this->isNegative))
+            throw std::overflow_error("Error: bigint does not fit in uint64_t.");
+        return this->isNegative ? 0 - word : word;
+    }
+
+    /**
+     * @brief Convert the number to the nearest double, with ties to even
+     * @return The number as double, infinity if it is beyond the range of double
+     */
+    double to_double() const
+    {
+        // Numbers of 310 digits are at least 10^309, beyond the largest double
+        if (this->digits.size() > 309)
+            return this->isNegative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+
+        std::array<char, 310> text{};
+        std::size_t length = 0;
+        if (this->isNegative)
+            text[length++] = '-';
+        for (std::size_t i = this->digits.size(); i > 0; i--)
+            text[length++] = static_cast<char>('0' + this->digits[i - 1]);
+
+        // from_chars rounds correctly and reports a result beyond the largest double as out of range
+        double result = 0;
+        const auto [end, error] = std::from_chars(text.data(), text.data() + length, result);
+        if (error == std::errc::result_out_of_range)
+            return this->isNegative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+        return result;
+    }
+
+    /**
+     * @brief Split the number into a mantissa and a power of two like std::frexp, also beyond the range of double.
+     * The mantissa is estimated from the leading 19 digits.
+     * @param exponent Receives the power of two, 0 for zero
+     * @return The mantissa, with an absolute value in [0.5, 1) and the sign of the number, 0 for zero
+     */
+    double frexp(std::int64_t &exponent) const
+    {
+        exponent = 0;
+        if (is_abs_zero(this->digits))
+            return 0.0;
+
+        std::int64_t decimal_exponent = 0;
+        int binary_exponent = 0;
+        double mantissa = std::frexp(static_cast<double>(leading_word(decimal_exponent)), &binary_exponent);
+
+        // 10^e = 2^(e * log2(10)), the fraction of the power of two goes into the mantissa
+        const long double scaled = static_cast<long double>(decimal_exponent) * 3.32192809488736234787L;
+        const long double whole = std::floor(scaled);
+        int carry = 0;
+        mantissa = std::frexp(mantissa * std::exp2(static_cast<double>(scaled - whole)), &carry);
+
+        exponent = binary_exponent + carry + static_cast<std::int64_t>(whole);
+        return this->isNegative ? -mantissa : mantissa;
+    }
+
+    /**
+     * @brief Estimate the base 2 logarithm of the absolute value from the leading 19 digits
+     * @return log2(|x|), negative infinity for zero
+     */
+    double log2() const
+    {
+        if (is_abs_zero(this->digits))
+            return -std::numeric_limits<double>::infinity();
+        std::int64_t decimal_exponent = 0;
+        const std::uint64_t word = leading_word(decimal_exponent);
+        return static_cast<double>(std::log2(static_cast<long double>(word)) +
+                                   static_cast<long double>(decimal_exponent) * 3.32192809488736234787L);
+    }
+
+    /**
+     * @brief Number of digits of the absolute value in the given base, like mpz_sizeinbase. The size is exact for base 10
+     * and for numbers that fit in a word, and otherwise exact or one too large.
+     * @param base The base, from 2 to 36
+     * @return The number of digits, 1 for zero
+     */
+    std::size_t size_in_base(int base) const
+    {
+        check_radix(base);
+        if (base == 10)
+            return this->digits.size();
+
+        bool fits = false;
+        std::uint64_t word = magnitude_word(fits);
+        if (fits)
+        {
+            std::size_t size = 1;
+            while (word >= static_cast<std::uint64_t>(base))
+            {
+                word /= static_cast<std::uint64_t>(base);
+                size++;
+            }
+            return size;
+        }
+
+        // Round up by more than the error of the estimate, so the size is never too small
+        const double digits_in_base = log2() / std::log2(static_cast<double>(base));
+        return static_cast<std::size_t>(digits_in_base * (1 + 1e-12) + 1e-9) + 1;
+    }
+
+    /**
+     * @brief Equality Operator: Check if a number equals the number stored in a binary view
+     * @param lhs The number to be compared
+     * @param rhs The view to be compared with
+     * @return True iff the two numbers are equal
+     */
+    friend bool operator==(const bigint &lhs, const bigint_view &rhs);
+
+    /**
+     * @brief Parse a number at the start of a char range, like std::from_chars for built-in integers
+     * Only a minus sign is accepted and no whitespace is skipped. Parsing stops at the first char that is not a digit
+     * in the base. Errors are reported through the result instead of exceptions. In base 10 the digits are validated
+     * and stored 8 at a time into the buffer of <value>, so a reused number does not allocate.
+     * @param first Start of the chars
+     * @param last End of the chars
+     * @param value Number to store the result, left unchanged if no digit is found
+     * @param base The base, from 2 to 36
+     * @return Pointer past the last digit parsed and an empty error code, or <first> and errc::invalid_argument
+     */
+    friend std::from_chars_result from_chars(const char *first, const char *last, bigint &value, int base = 10)
+    {
+        check_radix(base);
+        std::string_view str(first, static_cast<std::size_t>(last - first));
+        const bool negative = !str.empty() && str[0] == '-';
+        if (negative)
+            str.remove_prefix(1);
+
+        std::size_t length = 0;
+        if (base == 10)
+        {
+            length = count_leading_digits(str);
+        }
+        else
+        {
+            while (length < str.size() && radix_digit(str[length]) < base)
+                length++;
+        }
+        if (length == 0)
+            return {first, std::errc::invalid_argument};
+
+        str = str.substr(0, length);
+        if (base == 10)
+        {
+            const bigint_instrumentation::scope probe(bigint_kernel::parse, length);
+            store_digit_chars(str, value.digits);
+        }
+        else
+        {
+            value = bigint(str, base);
+        }
+        value.isNegative = negative && !is_abs_zero(value.digits);
+        return {str.data() + length, std::errc()};
+    }
+
+    /**
+     * @brief Write a number into a char range, like std::to_chars for built-in integers: with a leading '-' for negative
+     * numbers, the letters a-z for digits above 9 and no terminating null. Base 10 writes 8 digits per step straight into
+     * the range. Nothing is allocated in base 10.
+     * @param first Start of the range
+     * @param last End of the range
+     * @param value Number to be written
+     * @param base The base, from 2 to 36
+     * @return Pointer past the last char written and an empty error code, or <last> and errc::value_too_large if the
+     * number does not fit, in which case the contents of the range are unspecified
+     */
+    friend std::to_chars_result to_chars(char *first, char *last, const bigint &value, int base = 10)
+    {
+        const bigint_instrumentation::scope probe(bigint_kernel::format, value.digits.size());
+        const std::size_t size = value.formatted_size(base);
+        if (static_cast<std::size_t>(last - first) < size)
+            return {last, std::errc::value_too_large};
+
+        char *begin = first;
+        if (value.isNegative)
+            *begin++ = '-';
+        if (base == 10)
+            write_digit_chars(value.digits, begin);
+        else
+            value.write_radix_chars(begin, first + size, base);
+        return {first + size, std::errc()};
+    }
+
+    /**
+     * @brief Extraction Operator: Read a number from the input stream in fixed-size blocks
+     * Leading whitespace is skipped and reading stops at the first char that is not a digit, like the extraction of
+     * built-in integers. If no digit is found, failbit is set and <num> is left unchanged.
+     * @param stream Input stream to read the number from
+     * @param num Number to store the result
+     * @return The input stream after reading the number
+     */
+    friend std::istream &operator>>(std::istream &stream, bigint &num);
+
+    /**
+     * @brief Insertion Operator: Send the number to the output stream
+     * @param stream Output stream to send the number
+     * @param num Number to be sent
+     * @return The output stream after sending the number
+     */
+    friend std::ostream &operator<<(std::ostream &stream, const bigint &num)
+    {
+        const bigint_instrumentation::scope probe(bigint_kernel::format, num.digits.size());
+        // Reference: https://stackoverflow.com/questions/476272/how-can-i-properly-overload-the-operator-for-an-ostream
+        if (num.isNegative)
+            stream.put('-');
+
+        // Digits are formatted into a block on the stack and written with one call per block, most significant first
+        std::array<char, 4096> block{};
+        for (std::size_t end = num.digits.size(); end > 0;)
+        {
+            const std::size_t length = std::min(end, block.size());
+            write_digit_chars(std::span<const std::uint8_t>(num.digits).subspan(end - length, length), block.data());
+            stream.write(block.data(), static_cast<std::streamsize>(length));
+            end -= length;
+        }
+
+        return stream;
+    }
+};
+
+/**
+ * @brief Literal operator: Turn an integer literal into a bigint, e.g. 123456789012345678901234567890_big
+ * The literal is validated and split into digits at compile time, so only the digits are copied at runtime.
+ * @return The number written in the literal
+ */
+template <char... Chars>
+constexpr bigint operator""_big()
+{
+    constexpr auto image = bigint::parse_literal<Chars...>();
+    return bigint(std::span<const std::uint8_t>(image.digits.data(), image.size));
+}
+
+/**
+ * @brief Read-only view of a number in the binary format of <bigint::serialize>.
+ * The limbs are read straight out of the underlying byte buffer without copying, so the buffer must outlive the view.
+ */
+class bigint_view
+{
+private:
+    static constexpr std::size_t limb_digits = bigint::limb_digits;
+
+    friend class bigint;
+
+    const std::byte *data{};
+    std::size_t count{};
+    bool image{};
+
+    /**
+     * @brief Digits of the payload in the digit image encoding
+     * @return Pointer to the least significant digit
+     */
+    const std::uint8_t *image_digits() const
+    {
+        return reinterpret_cast<const std::uint8_t *>(this->data + bigint::serial_header_size);
+    }
+
+    /**
+     * @brief Get the digits of the viewed number in the layout used by the kernels
+     * @param scratch Buffer that receives the unpacked digits if the payload is made of limbs
+     * @return The digit image in place, or <scratch> after unpacking the limbs into it
+     */
+    std::span<const std::uint8_t> digit_span(std::vector<std::uint8_t> &scratch) const
+    {
+        if (this->image)
+            return {image_digits(), this->count};
+
+        scratch = bigint::limbs_to_digits(this->count, [&](std::size_t j) { return limb(j); });
+        return scratch;
+    }
+
+public:
+    /**
+     * @brief Buffer constructor: Validate the header and the length of a binary bigint
+     * @param buffer Bytes starting with the header, may be longer than the number
+     */
+    explicit bigint_view(std::span<const std::byte> buffer)
+    {
+        if (buffer.size() < bigint::serial_header_size)
+            throw std::invalid_argument("Error: Truncated binary bigint.");
+
+        const std::uint64_t payload = bigint::read_serial_header(buffer.data());
+        this->image = (std::to_integer<std::uint8_t>(buffer[5]) & bigint::serial_flag_digits) != 0;
+
+        const std::size_t unit = this->image ? 1 : 8;
+        if (payload > (buffer.size() - bigint::serial_header_size) / unit)
+            throw std::invalid_argument("Error: Truncated binary bigint.");
+
+        this->data = buffer.data();
+        this->count = static_cast<std::size_t>(payload);
+
+        // Zero has no limbs, so a zero top limb is not canonical
+        if (!this->image && this->count != 0 && limb(this->count - 1) == 0)
+            throw std::invalid_argument("Error: Top limb of binary bigint is zero.");
+
+        // The payload is used in place, so only its canonical form is checked to keep the view O(1). <validate> checks
+        // every digit.
+        if (this->image &&
+            (this->count == 0 || image_digits()[this->count - 1] > 9 || (this->count > 1 && image_digits()[this->count - 1] == 0)))
+            throw std::invalid_argument("Error: Digit image of binary bigint is not canonical.");
+    }
+
+    /**
+     * @brief Check every digit or limb of the payload, which the constructor leaves out to stay O(1). Call it once
+     * before a buffer from an untrusted source is used as an operand.
+     */
+    void validate() const
+    {
+        if (this->image)
+        {
+            if (std::any_of(image_digits(), image_digits() + this->count, [](std::uint8_t digit) { return digit > 9; }))
+                throw std::invalid_argument("Error: Digit out of range in binary bigint.");
+            return;
+        }
+        for (std::size_t j = 0; j < this->count; j++)
+        {
+            if (limb(j) >= bigint::limb_base)
+                throw std::invalid_argument("Error: Limb out of range in binary bigint.");
+        }
+    }
+
+    /**
+     * @brief Encoding of the payload of the viewed number
+     * @return binary_encoding::digits for a digit image, binary_encoding::limbs otherwise
+     */
+    bigint::binary_encoding encoding() const
+    {
+        return this->image ? bigint::binary_encoding::digits : bigint::binary_encoding::limbs;
+    }
+
+    /**
+     * @brief Check the sign of the viewed number
+     * @return True iff the number is negative
+     */
+    bool is_negative() const
+    {
+        return (std::to_integer<std::uint8_t>(this->data[5]) & bigint::serial_flag_negative) != 0 && limb_count() != 0;
+    }
+
+    /**
+     * @brief Number of 19-digit limbs of the magnitude
+     * @return The limb count, 0 for zero
+     */
+    std::size_t limb_count() const
+    {
+        if (!this->image)
+            return this->count;
+        if (this->count == 1 && image_digits()[0] == 0)
+            return 0;
+        return (this->count + limb_digits - 1) / limb_digits;
+    }
+
+    /**
+     * @brief Read one limb of the magnitude
+     * @param index Index of the limb, 0 is the least significant one
+     * @return The value of the limb
+     */
+    std::uint64_t limb(std::size_t index) const
+    {
+        if (!this->image)
+            return bigint::load_u64_le(this->data + bigint::serial_header_size + 8 * index);
+
+        const std::size_t begin = index * limb_digits;
+        const std::size_t end = std::min(begin + limb_digits, this->count);
+
+        std::uint64_t value = 0;
+        for (std::size_t i = end; i > begin; i--)
+            value = value * 10 + image_digits()[i - 1];
+        return value;
+    }
+
+    /**
+     * @brief Number of bytes covered by the view
+     * @return Size of the header and the payload
+     */
+    std::size_t size_bytes() const
+    {
+        return bigint::serial_header_size + (this->image ? 1 : 8) * this->count;
+    }
+
+    /**
+     * @brief Copy the viewed number into a bigint
+     * @return The viewed number
+     */
+    bigint to_bigint() const
+    {
+        return bigint::deserialize(std::span<const std::byte>(this->data, size_bytes()));
+    }
+
+    /**
+     * @brief Insertion Operator: Send the viewed number to the output stream without copying it into a bigint
+     * @param stream Output stream to send the number
+     * @param view View of the number
+     * @return The output stream after sending the number
+     */
+    friend std::ostream &operator<<(std::ostream &stream, const bigint_view &view)
+    {
+        const std::size_t limbs = view.limb_count();
+        if (limbs == 0)
+            return stream << '0';
+        if (view.is_negative())
+            stream << '-';
+
+        stream << view.limb(limbs - 1);
+        for (std::size_t j = limbs - 1; j > 0; j--)
+        {
+            std::array<char, limb_digits> chunk{};
+            std::uint64_t value = view.limb(j - 1);
+            for (std::size_t k = chunk.size(); k > 0; k--)
+            {
+                chunk[k - 1] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+            stream.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        }
+        return stream;
+    }
+};
+
+inline bigint bigint::deserialize(std::span<const std::byte> buffer)
+{
+    const bigint_view view(buffer);
+
+    bigint result;
+    std::vector<std::uint8_t> scratch;
+    const std::span<const std::uint8_t> digits = view.digit_span(scratch);
+    if (scratch.empty())
+    {
+        // Limbs were checked while unpacking, a digit image is checked here before it enters a bigint
+        view.validate();
+        scratch = scratch_pool::acquire(digits.size());
+        std::copy(digits.begin(), digits.end(), scratch.begin());
+    }
+    result.replace_digits(std::move(scratch));
+    result.isNegative = view.is_negative();
+    return result;
+}
+
+inline bool operator==(const bigint &lhs, const bigint_view &rhs)
+{
+    if (lhs.isNegative != rhs.is_negative() || lhs.limb_count() != rhs.limb_count())
+        return false;
+
+    for (std::size_t j = 0; j < rhs.limb_count(); j++)
+    {
+        if (lhs.limb_at(j) != rhs.limb(j))
+            return false;
+    }
+    return true;
+}
+
+inline bigint &bigint::operator+=(const bigint_view &rhs)
+{
+    std::vector<std::uint8_t> scratch;
+    add_signed(rhs.digit_span(scratch), rhs.is_negative());
+    scratch_pool::release(std::move(scratch));
+    return *this;
+}
+
+inline bigint &bigint::operator-=(const bigint_view &rhs)
+{
+    std::vector<std::uint8_t> scratch;
+    add_signed(rhs.digit_span(scratch), !rhs.is_negative() && rhs.limb_count() != 0);
+    scratch_pool::release(std::move(scratch));
+    return *this;
+}
+
+inline bigint &bigint::operator*=(const bigint_view &rhs)
+{
+    std::vector<std::uint8_t> scratch;
+    multiply_signed(rhs.digit_span(scratch), rhs.is_negative());
+    scratch_pool::release(std::move(scratch));
+    return *this;
+}
+
+inline bigint &bigint::operator/=(const bigint_view &rhs)
+{
+    std::vector<std::uint8_t> scratch;
+    divide_signed(rhs.digit_span(scratch), rhs.is_negative());
+    scratch_pool::release(std::move(scratch));
+    return *this;
+}
+
+inline bigint &bigint::operator%=(const bigint_view &rhs)
+{
+    std::vector<std::uint8_t> scratch;
+    modulo_signed(rhs.digit_span(scratch));
+    scratch_pool::release(std::move(scratch));
+    return *this;
+}
+
+/**
+ * @brief Incremental parser that builds a number from decimal text arriving in chunks.
+ * Chunks are validated and appended as they arrive, so the text never has to be buffered as a whole. The digits are
+ * kept in arrival order and reversed once when the number is finished.
+ */
+class bigint_parser
+{
+private:
+    std::vector<std::uint8_t> pending; // Digits without leading zeros, most significant first
+    bool negative = false;
+    bool has_sign = false;
+    bool has_digit = false;
+    bool started = false;
+
+public:
+    /**
+     * @brief Validate and consume the next chunk of text
+     * @param chunk Chars following the previous chunk. Only the very first char of the text may be a sign.
+     */
+    void feed(std::string_view chunk)
+    {
+        std::size_t start = 0;
+        if (!this->started && !chunk.empty())
+        {
+            this->started = true;
+            if (chunk[0] == '-' || chunk[0] == '+')
+            {
+                this->negative = chunk[0] == '-';
+                this->has_sign = true;
+                start = 1;
+            }
+        }
+
+        for (std::size_t i = start; i < chunk.size(); i++)
+        {
+            const char c = chunk[i];
+            if (c < '0' || c > '9')
+                throw std::invalid_argument("Error: String contains non-digit char.");
+
+            this->has_digit = true;
+            // Leading zeros are dropped as they arrive
+            if (!this->pending.empty() || c != '0')
+                this->pending.push_back(static_cast<std::uint8_t>(c - '0'));
+        }
+    }
+
+    /**
+     * @brief Build the number from all chunks fed so far and reset the parser
+     * @return The parsed number
+     */
+    bigint finish()
+    {
+        if (!this->started)
+            throw std::invalid_argument("Empty string is not permitted");
+        if (!this->has_digit)
+        {
+            *this = bigint_parser();
+            throw std::invalid_argument("Error: String contains only a sign char.");
+        }
+
+        bigint result;
+        if (!this->pending.empty())
+        {
+            std::reverse(this->pending.begin(), this->pending.end());
+            result.replace_digits(std::move(this->pending));
+            result.isNegative = this->negative;
+        }
+
+        *this = bigint_parser();
+        return result;
+    }
+};
+
+inline std::istream &operator>>(std::istream &stream, bigint &num)
+{
+    // Reference: https://en.cppreference.com/w/cpp/io/basic_istream/sentry
+    const std::istream::sentry sentry(stream);
+    if (!sentry)
+        return stream;
+
+    std::streambuf *buffer = stream.rdbuf();
+    std::array<char, 4096> block{};
+    std::size_t used = 0;
+    bool has_digit = false;
+    bigint_parser parser;
+
+    int c = buffer->sgetc();
+    if (c == '-' || c == '+')
+    {
+        block[used++] = static_cast<char>(c);
+        c = buffer->snextc();
+    }
+
+    while (c != std::char_traits<char>::eof() && c >= '0' && c <= '9')
+    {
+        block[used++] = static_cast<char>(c);
+        has_digit = true;
+        if (used == block.size())
+        {
+            parser.feed({block.data(), used});
+            used = 0;
+        }
+        c = buffer->snextc();
+    }
+
+    if (c == std::char_traits<char>::eof())
+        stream.setstate(std::ios::eofbit);
+    if (!has_digit)
+    {
+        stream.setstate(std::ios::failbit);
+        return stream;
+    }
+
+    parser.feed({block.data(), used});
+    num = parser.finish();
+    return stream;
+}
+
+/**
+ * @brief Accumulator for long sums of numbers and products with deferred carry propagation.
+ * Every decimal position has a wide signed lane, and terms are added lane by lane without any carry. Carries are
+ * propagated only when the result is read, or when the lanes could overflow.
+ */
+class bigint_accumulator
+{
+private:
+    static constexpr std::uint64_t lane_limit = std::uint64_t{1} << 62;
+
+    std::vector<std::int64_t> lanes{0}; // lanes[i] is the coefficient of 10^i
+    std::uint64_t bound = 0;           // Upper bound of the magnitude of every lane
+
+    /**
+     * @brief Make sure the lanes can absorb <growth> more without overflowing, and that there are <size> lanes
+     * @param growth Largest magnitude the next operation adds to a single lane
+     * @param size Number of lanes the next operation touches
+     */
+    void reserve(std::uint64_t growth, std::size_t size)
+    {
+        if (this->bound + growth > lane_limit)
+            normalize();
+        if (this->lanes.size() < size)
+            this->lanes.resize(size);
+        this->bound += growth;
+    }
+
+    /**
+     * @brief Propagate the carries so that every lane is a digit, except the top lane which may be -1 for a negative sum
+     */
+    void normalize()
+    {
+        std::int64_t carry = 0;
+        for (auto &lane : this->lanes)
+        {
+            const std::int64_t value = lane + carry;
+            // Floor division keeps every lane in [0, 9]
+            carry = value / 10 - (value % 10 < 0 ? 1 : 0);
+            lane = value - carry * 10;
+        }
+
+        while (carry != 0 && carry != -1)
+        {
+            const std::int64_t next = carry / 10 - (carry % 10 < 0 ? 1 : 0);
+            this->lanes.push_back(carry - next * 10);
+            carry = next;
+        }
+        if (carry == -1)
+            this->lanes.push_back(-1);
+
+        // A top lane of -1 becomes 9 with a new -1 above it on every pass, and 9 * 10^i - 10^(i + 1) = -10^i, so fold
+        // the pair back or a running total read in a loop would gain a lane per read
+        while (this->lanes.size() > 1 && this->lanes[this->lanes.size() - 2] == 9 && this->lanes.back() == -1)
+        {
+            this->lanes.pop_back();
+            this->lanes.back() = -1;
+        }
+
+        this->bound = 9;
+    }
+
+    /**
+     * @brief Add <sign> * <digits> to the lanes without carrying
+     * @param digits Digits of the magnitude to be added
+     * @param sign 1 or -1
+     */
+    void add_lanes(std::span<const std::uint8_t> digits, std::int64_t sign)
+    {
+        reserve(9, digits.size());
+        for (std::size_t i = 0; i < digits.size(); i++)
+            this->lanes[i] += sign * digits[i];
+    }
+
+public:
+    /**
+     * @brief Add a number to the sum
+     * @param num Number to be added
+     */
+    void add(const bigint &num)
+    {
+        add_lanes(num.digits, num.isNegative ? -1 : 1);
+    }
+
+    /**
+     * @brief Subtract a number from the sum
+     * @param num Number to be subtracted
+     */
+    void sub(const bigint &num)
+    {
+        add_lanes(num.digits, num.isNegative ? 1 : -1);
+    }
+
+    /**
+     * @brief Add the product of two numbers to the sum, without building the product first
+     * @param lhs The first factor
+     * @param rhs The second factor
+     */
+    void addmul(const bigint &lhs, const bigint &rhs)
+    {
+        if (bigint::is_abs_zero(lhs.digits) || bigint::is_abs_zero(rhs.digits))
+            return;
+
+        const std::int64_t sign = lhs.isNegative != rhs.isNegative ? -1 : 1;
+        const std::size_t overlap = std::min(lhs.digits.size(), rhs.digits.size());
+        reserve(81 * static_cast<std::uint64_t>(overlap), lhs.digits.size() + rhs.digits.size() - 1);
+
+        for (std::size_t i = 0; i < lhs.digits.size(); i++)
+        {
+            const std::int64_t factor = sign * lhs.digits[i];
+            if (factor == 0)
+                continue;
+            for (std::size_t j = 0; j < rhs.digits.size(); j++)
+                this->lanes[i + j] += factor * rhs.digits[j];
+        }
+    }
+
+    /**
+     * @brief Normalize the lanes and read the sum
+     * @return The sum of all terms added so far
+     */
+    bigint value()
+    {
+        normalize();
+
+        bigint result;
+        std::vector<std::uint8_t> magnitude = bigint::scratch_pool::acquire(this->lanes.size());
+        const bool negative = this->lanes.back() == -1;
+
+        if (negative)
+        {
+            // The lanes hold the sum plus 10^n, so the magnitude is the ten's complement of the lower lanes
+            std::int64_t borrow = 0;
+            for (std::size_t i = 0; i + 1 < this->lanes.size(); i++)
+            {
+                std::int64_t digit = -this->lanes[i] - borrow;
+                borrow = digit < 0 ? 1 : 0;
+                magnitude[i] = static_cast<std::uint8_t>(digit + 10 * borrow);
+            }
+            // Without a final borrow the lower lanes are all zero and the magnitude is 10^(n - 1) itself
+            magnitude.back() = static_cast<std::uint8_t>(1 - borrow);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < this->lanes.size(); i++)
+                magnitude[i] = static_cast<std::uint8_t>(this->lanes[i]);
+        }
+
+        bigint::remove_leading_zeros(magnitude);
+        result.replace_digits(std::move(magnitude));
+        result.isNegative = negative && !bigint::is_abs_zero(result.digits);
+        return result;
+    }
+
+    /**
+     * @brief Number of lanes currently held
+     * @return The lane count, which bounds the memory held by the accumulator
+     */
+    std::size_t lane_count() const
+    {
+        return this->lanes.size();
+    }
+
+    /**
+     * @brief Reset the sum to zero, keeping the lanes allocated
+     */
+    void clear()
+    {
+        std::fill(this->lanes.begin(), this->lanes.end(), 0);
+        this->bound = 0;
+    }
+};
+
+/**
+ * @brief Product tree of a fixed list of moduli, for reducing a number by all of them at once and for CRT reconstruction.
+ * The tree is built once with a reciprocal of every node and reused by every batch. Each node reduces with a Barrett
+ * step of two multiplications, so a batch costs about as much as a few multiplications of the size of the whole product
+ * per level instead of one full division per modulus.
+ */
+class bigint_remainder_tree
+{
+private:
+    // levels[0] holds the moduli, and levels[k + 1][j] is the product of levels[k][2j] and levels[k][2j + 1].
+    // The last node of a level with an odd size is carried up unchanged.
+    std::vector<std::vector<bigint>> levels;
+
+    // inverses[k][j] is the inverse of levels[k][2j] modulo levels[k][2j + 1], computed on the first CRT reconstruction
+    std::vector<std::vector<bigint>> inverses;
+
+    // reciprocals[k][j] is floor(10^p / levels[k][j]), give or take a few units, for the precision p of the node
+    std::vector<std::vector<bigint>> reciprocals;
+
+    static constexpr std::size_t reciprocal_base = 2 * bigint::karatsuba_threshold; // Digits below which a reciprocal is found by long division
+
+    /**
+     * @brief Least non-negative remainder of a division
+     * @param num The number to be divided
+     * @param modulus The positive modulus
+     * @return <num> modulo <modulus> in [0, modulus)
+     */
+    static bigint reduce_one(const bigint &num, const bigint &modulus)
+    {
+        bigint remainder = num % modulus;
+        if (remainder < bigint())
+            remainder += modulus;
+        return remainder;
+    }
+
+    /**
+     * @brief Reciprocal of a number with Newton's method, so its cost is a few multiplications of its size. A reciprocal
+     * y with a little over half the digits is refined to x = y * 10^h + y * (10^(p - h) - m * y) / 10^(p - 2h), which
+     * squares its relative error.
+     * @param modulus The positive number
+     * @param precision Power of ten p, at least the number of digits of <modulus> minus 1
+     * @return floor(10^p / modulus), exact for short results and within a few units otherwise
+     */
+    static bigint reciprocal(const bigint &modulus, std::size_t precision)
+    {
+        const std::size_t size = modulus.digits.size();
+        const std::size_t length = precision + 1 - size; // Digits of the result, give or take one
+        if (length <= reciprocal_base)
+            return bigint(1).multiply_pow10(precision) / modulus;
+
+        // Only the top digits of the modulus matter for the estimate, with two guard digits
+        const std::size_t cut = size > length + 2 ? size - length - 2 : 0;
+        const std::size_t half = length / 2 - 1;
+        bigint top = modulus;
+        top.divide_pow10(cut);
+        const bigint estimate = reciprocal(top, precision - cut - half);
+
+        bigint residual(1);
+        residual.multiply_pow10(precision - cut - half);
+        residual -= top * estimate;
+        bigint result = estimate * residual;
+        result.divide_pow10(precision - cut - 2 * half);
+        result += bigint(estimate).multiply_pow10(half);
+        return result;
+    }
+
+    /**
+     * @brief Precision of the reciprocal of a node. A remainder reduced by the node is below its parent, and a CRT step
+     * reduces a product below the parent too, so both stay below 10^p.
+     * @param k Level of the node
+     * @param j Index of the node in its level
+     * @return The power of ten p
+     */
+    std::size_t precision(std::size_t k, std::size_t j) const
+    {
+        const std::size_t size = this->levels[k][j].digits.size();
+        const std::size_t parent = k + 1 < this->levels.size() ? this->levels[k + 1][j / 2].digits.size() : 0;
+        return std::max(2 * size, parent);
+    }
+
+    /**
+     * @brief Least non-negative remainder of a division with Barrett reduction, from two multiplications
+     * @param num The number to be divided, below 10^precision in absolute value for a quick result
+     * @param modulus The positive modulus
+     * @param inverse floor(10^precision / modulus), give or take a few units
+     * @param precision Power of ten of the reciprocal
+     * @return <num> modulo <modulus> in [0, modulus)
+     */
+    static bigint reduce_with(const bigint &num, const bigint &modulus, const bigint &inverse, std::size_t precision)
+    {
+        // Reference: https://en.wikipedia.org/wiki/Barrett_reduction
+        const std::size_t size = modulus.digits.size();
+        bigint quotient = num;
+        quotient.isNegative = false;
+        quotient.divide_pow10(size - 1);
+        quotient *= inverse;
+        quotient.divide_pow10(precision - size + 1);
+
+        // The estimated quotient is off by a few units at most, since the number is below 10^precision
+        bigint remainder = num;
+        remainder.isNegative = false;
+        remainder -= quotient * modulus;
+        while (remainder.isNegative)
+            remainder += modulus;
+        while (remainder >= modulus)
+            remainder -= modulus;
+        if (num.isNegative && !bigint::is_abs_zero(remainder.digits))
+            remainder = modulus - remainder;
+        return remainder;
+    }
+
+    /**
+     * @brief Inverse of a number modulo <modulus> with the extended Euclidean algorithm
+     * @param num The number to be inverted
+     * @param modulus The positive modulus
+     * @return x in [0, modulus) with num * x = 1 (mod modulus)
+     */
+    static bigint inverse(const bigint &num, const bigint &modulus)
+    {
+        // Reference: https://en.wikipedia.org/wiki/Extended_Euclidean_algorithm
+        bigint old_r = reduce_one(num, modulus), r = modulus;
+        bigint old_s(1), s;
+        while (r != bigint())
+        {
+            const bigint q = old_r / r;
+            old_r = std::exchange(r, old_r - q * r);
+            old_s = std::exchange(s, old_s - q * s);
+        }
+        if (old_r != bigint(1))
+            throw std::invalid_argument("Error: Moduli are not pairwise coprime.");
+        return reduce_one(old_s, modulus);
+    }
+
+    /**
+     * @brief Compute the inverses of the left children modulo the right children, once for the lifetime of the tree
+     */
+    void build_inverses()
+    {
+        if (!this->inverses.empty())
+            return;
+        for (std::size_t k = 0; k + 1 < this->levels.size(); k++)
+        {
+            const std::vector<bigint> &level = this->levels[k];
+            std::vector<bigint> row;
+            row.reserve(level.size() / 2);
+            for (std::size_t j = 0; j + 1 < level.size(); j += 2)
+                row.push_back(inverse(level[j], level[j + 1]));
+            this->inverses.push_back(std::move(row));
+        }
+    }
+
+public:
+    /**
+     * @brief Moduli constructor: Build the product tree
+     * @param moduli The moduli, all positive
+     */
+    explicit bigint_remainder_tree(std::span<const bigint> moduli)
+    {
+        for (const bigint &modulus : moduli)
+        {
+            if (modulus <= bigint())
+                throw std::invalid_argument("Error: Moduli must be positive.");
+        }
+
+        this->levels.emplace_back(moduli.begin(), moduli.end());
+        while (this->levels.back().size() > 1)
+        {
+            const std::vector<bigint> &level = this->levels.back();
+            std::vector<bigint> next;
+            next.reserve((level.size() + 1) / 2);
+            for (std::size_t j = 0; j + 1 < level.size(); j += 2)
+                next.push_back(level[j] * level[j + 1]);
+            if (level.size() % 2 == 1)
+                next.push_back(level.back());
+            this->levels.push_back(std::move(next));
+        }
+
+        // Only the root needs Newton's method. A child with sibling b gets 1 / a = b / (a * b) from its parent.
+        if (size() == 0)
+            return;
+        const std::size_t top = this->levels.size() - 1;
+        this->reciprocals.resize(this->levels.size());
+        this->reciprocals[top].push_back(reciprocal(this->levels[top].front(), precision(top, 0)));
+        for (std::size_t k = top; k > 0; k--)
+        {
+            const std::vector<bigint> &level = this->levels[k - 1];
+            for (std::size_t j = 0; j < level.size(); j++)
+            {
+                bigint estimate = this->reciprocals[k][j / 2];
+                std::size_t shift = precision(k, j / 2) - precision(k - 1, j);
+                if ((j ^ 1) < level.size())
+                {
+                    // Digits of the parent's reciprocal that the shift drops after the product add less than a unit
+                    const std::size_t sibling = level[j ^ 1].digits.size();
+                    const std::size_t trim = shift > sibling + 2 ? shift - sibling - 2 : 0;
+                    estimate.divide_pow10(trim);
+                    estimate *= level[j ^ 1];
+                    shift -= trim;
+                }
+                estimate.divide_pow10(shift);
+                this->reciprocals[k - 1].push_back(std::move(estimate));
+            }
+        }
+    }
+
+    /**
+     * @brief Number of moduli in the tree
+     * @return The count
+     */
+    std::size_t size() const
+    {
+        return this->levels.front().size();
+    }
+
+    /**
+     * @brief Product of all moduli, the root of the tree
+     * @return The product, 1 for an empty tree
+     */
+    bigint product() const
+    {
+        return this->levels.back().empty() ? bigint(1) : this->levels.back().front();
+    }
+
+    /**
+     * @brief Reduce a number by every modulus with a remainder tree. The number is reduced by the root first, and every
+     * remainder is then reduced by the two children of its node, so the reductions shrink on the way down.
+     * @param num The number to be reduced
+     * @return The least non-negative remainder of <num> by each modulus, in the order of the moduli
+     */
+    std::vector<bigint> reduce(const bigint &num) const
+    {
+        if (size() == 0)
+            return {};
+
+        // A number beyond the reach of the cached reciprocal of the root gets a reciprocal of its own size
+        const std::size_t top = this->levels.size() - 1;
+        const bigint &root = this->levels[top].front();
+        const std::size_t reach = precision(top, 0);
+        std::vector<bigint> remainders{
+            num.digits.size() <= reach ? reduce_with(num, root, this->reciprocals[top].front(), reach)
+                                       : reduce_with(num, root, reciprocal(root, num.digits.size()), num.digits.size())};
+        for (std::size_t k = this->levels.size() - 1; k > 0; k--)
+        {
+            const std::vector<bigint> &level = this->levels[k - 1];
+            std::vector<bigint> next;
+            next.reserve(level.size());
+            for (std::size_t j = 0; j < level.size(); j++)
+            {
+                // A node carried up unchanged already holds the remainder by its only child
+                if (j % 2 == 0 && j + 1 == level.size())
+                    next.push_back(std::move(remainders[j / 2]));
+                else
+                    next.push_back(reduce_with(remainders[j / 2], level[j], this->reciprocals[k - 1][j], precision(k - 1, j)));
+            }
+            remainders = std::move(next);
+        }
+        return remainders;
+    }
+
+    /**
+     * @brief Chinese remainder theorem: Find the number with the given remainder by each modulus. Pairs of nodes are
+     * combined from the leaves up, with the inverse of the left modulus cached in the tree.
+     * @param residues The remainder by each modulus, in the order of the moduli
+     * @return The unique number in [0, product()) with these remainders
+     */
+    bigint combine(std::span<const bigint> residues)
+    {
+        if (residues.size() != size())
+            throw std::invalid_argument("Error: Number of residues does not match the number of moduli.");
+        if (size() == 0)
+            return bigint();
+        build_inverses();
+
+        std::vector<bigint> values;
+        values.reserve(residues.size());
+        for (std::size_t i = 0; i < residues.size(); i++)
+            values.push_back(reduce_one(residues[i], this->levels[0][i]));
+
+        for (std::size_t k = 0; k + 1 < this->levels.size(); k++)
+        {
+            const std::vector<bigint> &level = this->levels[k];
+            std::size_t count = 0;
+            for (std::size_t j = 0; j + 1 < level.size(); j += 2)
+            {
+                // x = a + A * ((b - a) * A^-1 mod B) is a modulo A and b modulo B
+                const bigint step = reduce_with((values[j + 1] - values[j]) * this->inverses[k][j / 2], level[j + 1],
+                                                this->reciprocals[k][j + 1], precision(k, j + 1));
+                values[j] += level[j] * step;
+                if (count != j)
+                    values[count] = std::move(values[j]);
+                count++;
+            }
+            if (level.size() % 2 == 1)
+                values[count++] = std::move(values.back());
+            values.resize(count);
+        }
+        return std::move(values.front());
+    }
+};
+
+/**
+ * @brief Reduce a number by many moduli at once with a remainder tree
+ * @param num The number to be reduced
+ * @param moduli The moduli, all positive
+ * @return The least non-negative remainder of <num> by each modulus
+ */
+inline std::vector<bigint> multi_mod(const bigint &num, std::span<const bigint> moduli)
+{
+    return bigint_remainder_tree(moduli).reduce(num);
+}
+
+/**
+ * @brief Chinese remainder theorem: Reconstruct a number from its remainders by pairwise coprime moduli
+ * @param residues The remainder by each modulus
+ * @param moduli The moduli, all positive and pairwise coprime
+ * @return The unique number in [0, product of the moduli) with these remainders
+ */
+inline bigint crt(std::span<const bigint> residues, std::span<const bigint> moduli)
+{
+    return bigint_remainder_tree(moduli).combine(residues);
+}
+
+/**
+ * @brief Immutable number with its hash computed once on construction, for keys that are hashed repeatedly
+ */
+class hashed_bigint
+{
+private:
+    bigint num;
+    std::size_t cached;
+
+public:
+    /**
+     * @brief Bigint constructor: Store the number and compute its hash
+     * @param num Number to be stored
+     */
+    explicit hashed_bigint(bigint num) : num(std::move(num)), cached(this->num.hash())
+    {
+    }
+
+    /**
+     * @brief Access the stored number
+     * @return The stored number
+     */
+    const bigint &value() const noexcept
+    {
+        return this->num;
+    }
+
+    /**
+     * @brief Get the hash computed on construction
+     * @return The cached hash
+     */
+    std::size_t hash() const noexcept
+    {
+        return this->cached;
+    }
+
+    /**
+     * @brief Equality Operator: Compare the cached hashes before the digits
+     * @param rhs The number to be compared with
+     * @return True iff the two numbers are equal
+     */
+    bool operator==(const hashed_bigint &rhs) const
+    {
+        return this->cached == rhs.cached && this->num == rhs.num;
+    }
+};
+
+template <>
+struct std::hash<bigint>
+{
+    std::size_t operator()(const bigint &num) const noexcept
+    {
+        return num.hash();
+    }
+};
+
+template <>
+struct std::hash<hashed_bigint>
+{
+    std::size_t operator()(const hashed_bigint &num) const noexcept
+    {
+        return num.hash();
+    }
+};
+
+#ifdef __cpp_lib_format
+/**
+ * @brief Formatter for std::format, with the spec [[fill]align][sign][#][0][width][type] of built-in integers.
+ * The type is d (default), b, B, o, x or X, and # adds the prefix 0b, 0B, 0 or 0x, 0X. The digits are written with
+ * <to_chars> into one buffer and copied to the output with the padding.
+ */
+template <>
+struct std::formatter<bigint>
+{
+    char fill = ' ';
+    char align = 0; // '<', '>' or '^', 0 for the default right alignment
+    char sign = '-';
+    bool alternate = false;
+    bool zero_pad = false;
+    bool uppercase = false;
+    std::size_t width = 0;
+    int base = 10;
+
+    constexpr std::format_parse_context::iterator parse(std::format_parse_context &ctx)
+    {
+        const auto is_align = [](char c) { return c == '<' || c == '>' || c == '^'; };
+        auto it = ctx.begin();
+        const auto end = ctx.end();
+        if (it != end && it + 1 != end && is_align(*(it + 1)))
+        {
+            this->fill = *it;
+            this->align = *(it + 1);
+            it += 2;
+        }
+        else if (it != end && is_align(*it))
+        {
+            this->align = *it++;
+        }
+
+        if (it != end && (*it == '+' || *it == '-' || *it == ' '))
+            this->sign = *it++;
+        if (it != end && *it == '#')
+        {
+            this->alternate = true;
+            ++it;
+        }
+        if (it != end && *it == '0')
+        {
+            this->zero_pad = true;
+            ++it;
+        }
+        while (it != end && *it >= '0' && *it <= '9')
+            this->width = this->width * 10 + static_cast<std::size_t>(*it++ - '0');
+
+        if (it != end && *it != '}')
+        {
+            switch (*it++)
+            {
+            case 'd':
+                this->base = 10;
+                break;
+            case 'B':
+                this->uppercase = true;
+                [[fallthrough]];
+            case 'b':
+                this->base = 2;
+                break;
+            case 'o':
+                this->base = 8;
+                break;
+            case 'X':
+                this->uppercase = true;
+                [[fallthrough]];
+            case 'x':
+                this->base = 16;
+                break;
+            default:
+                throw std::format_error("Error: Invalid type in the format spec of bigint.");
+            }
+        }
+        if (it != end && *it != '}')
+            throw std::format_error("Error: Invalid format spec of bigint.");
+        return it;
+    }
+
+    template <typename FormatContext>
+    typename FormatContext::iterator format(const bigint &num, FormatContext &ctx) const
+    {
+        std::string digits(num.formatted_size(this->base), '\0');
+        to_chars(digits.data(), digits.data() + digits.size(), num, this->base);
+
+        std::string prefix;
+        if (digits[0] == '-')
+        {
+            prefix.push_back('-');
+            digits.erase(0, 1);
+        }
+        else if (this->sign != '-')
+        {
+            prefix.push_back(this->sign);
+        }
+        // Like built-in integers, zero gets no octal prefix
+        if (this->alternate && this->base != 10 && !(this->base == 8 && digits == "0"))
+            prefix += this->base == 2 ? "0b" : this->base == 8 ? "0" : "0x";
+        if (this->uppercase)
+        {
+            for (char &c : prefix)
+                c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            for (char &c : digits)
+                c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+
+        const std::size_t size = prefix.size() + digits.size();
+        const std::size_t padding = this->width > size ? this->width - size : 0;
+        auto out = ctx.out();
+        if (this->zero_pad && this->align == 0)
+        {
+            // Zeros go between the sign or prefix and the digits
+            out = std::copy(prefix.begin(), prefix.end(), out);
+            out = std::fill_n(out, padding, '0');
+            return std::copy(digits.begin(), digits.end(), out);
+        }
+
+        const std::size_t before = this->align == '<' ? 0 : this->align == '^' ? padding / 2 : padding;
+        out = std::fill_n(out, before, this->fill);
+        out = std::copy(prefix.begin(), prefix.end(), out);
+        out = std::copy(digits.begin(), digits.end(), out);
+        return std::fill_n(out, padding - before, this->fill);
+    }
+};
+#endif
 
 #endif
@@ -0,0 +1,365 @@
+#ifndef BIGINT_ASYNC_HPP
+#define BIGINT_ASYNC_HPP
+
+#include "bigint.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief How an asynchronous operation can be stopped and observed
+ */
+struct bigint_async_options
+{
+    std::stop_token stop;                 // Cancels the operation when a stop is requested
+    std::function<void(double)> progress; // Called on the worker thread with the finished fraction, may be empty
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+};
+
+/**
+ * @brief Run a calculation on a new thread under a control built from <options>
+ * @param options Cancellation token, progress callback and deadline
+ * @param task The calculation
+ * @return Future of the result. Its get() throws bigint_cancelled if the operation was cancelled.
+ */
+template <typename Task>
+auto bigint_run_async(bigint_async_options options, Task task) -> std::future<decltype(task())>
+{
+    return std::async(std::launch::async,
+                      [options = std::move(options), task = std::move(task)]() mutable
+                      {
+                          bigint_control control(options.stop, std::move(options.progress), options.deadline);
+                          const bigint_control::activation active(control);
+                          return task();
+                      });
+}
+
+/**
+ * @brief Multiply two numbers on a new thread
+ * @param lhs The first factor
+ * @param rhs The second factor
+ * @param options Cancellation token, progress callback and deadline
+ * @return Future of the product
+ */
+inline std::future<bigint> multiply_async(bigint lhs, bigint rhs, bigint_async_options options = {})
+{
+    return bigint_run_async(std::move(options), [lhs = std::move(lhs), rhs = std::move(rhs)]() { return lhs * rhs; });
+}
+
+/**
+ * @brief Divide two numbers on a new thread
+ * @param lhs The dividend
+ * @param rhs The divisor
+ * @param options Cancellation token, progress callback and deadline
+ * @return Future of the quotient, truncated like operator/
+ */
+inline std::future<bigint> divide_async(bigint lhs, bigint rhs, bigint_async_options options = {})
+{
+    return bigint_run_async(std::move(options), [lhs = std::move(lhs), rhs = std::move(rhs)]() { return lhs / rhs; });
+}
+
+/**
+ * @brief Take the remainder of the division of two numbers on a new thread
+ * @param lhs The dividend
+ * @param rhs The divisor
+ * @param options Cancellation token, progress callback and deadline
+ * @return Future of the remainder, with the sign of the dividend like operator%
+ */
+inline std::future<bigint> modulo_async(bigint lhs, bigint rhs, bigint_async_options options = {})
+{
+    return bigint_run_async(std::move(options), [lhs = std::move(lhs), rhs = std::move(rhs)]() { return lhs % rhs; });
+}
+
+/**
+ * @brief Convert a number to a string on a new thread
+ * @param num The number
+ * @param base The base, from 2 to 36
+ * @param options Cancellation token, progress callback and deadline
+ * @return Future of the string
+ */
+inline std::future<std::string> to_string_async(bigint num, int base = 10, bigint_async_options options = {})
+{
+    return bigint_run_async(std::move(options), [num = std::move(num), base]() { return num.to_string(base); });
+}
+
+/**
+ * @brief Parse a string of digits in the given base on a new thread
+ * @param text The string, with an optional sign
+ * @param base The base, from 2 to 36
+ * @param options Cancellation token, progress callback and deadline
+ * @return Future of the number
+ */
+inline std::future<bigint> parse_async(std::string text, int base = 10, bigint_async_options options = {})
+{
+    return bigint_run_async(std::move(options), [text = std::move(text), base]() { return bigint(text, base); });
+}
+
+/**
+ * @brief Multi-threaded multiplication and string conversion for huge numbers.
+ * Work is split into halves, or thirds for Karatsuba, and each part runs on its own thread until the thread budget is
+ * used up or the parts are smaller than <grain> digits. A budget of 0 uses every hardware thread.
+ * Every part runs under the stop token and deadline of the control active on the calling thread, so a parallel
+ * operation inside bigint_run_async can be cancelled like a sequential one. Progress is only reported for the parts
+ * of the calling thread.
+ */
+class bigint_parallel
+{
+private:
+    static constexpr std::size_t grain = std::size_t(1) << 15; // Digits or chars below which a part is not split
+
+    /**
+     * @brief Number of threads to use
+     * @param threads Requested number of threads, 0 for every hardware thread
+     * @return At least 1
+     */
+    static unsigned budget(unsigned threads)
+    {
+        return threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /**
+     * @brief Run a part on a new thread under a control that shares the stop token and deadline of the calling thread
+     * @param task The part
+     * @return Future of the result of the part
+     */
+    template <typename Task>
+    static auto spawn(Task task) -> std::future<decltype(task())>
+    {
+        return std::async(std::launch::async,
+                          [control = bigint_control::for_worker(), task = std::move(task)]() mutable
+                          {
+                              const bigint_control::activation active(control);
+                              return task();
+                          });
+    }
+
+    /**
+     * @brief Split a number at a decimal position, for free since the digits are decimal
+     * @param num The number, equal to high * 10^m + low afterwards, with both parts of its sign
+     * @param m Position of the split
+     * @param high Receives the digits above the position
+     * @param low Receives the digits below the position
+     */
+    static void split(const bigint &num, std::size_t m, bigint &high, bigint &low)
+    {
+        high = num;
+        high.divide_pow10(m);
+        low = num;
+        low.modulo_pow10(m);
+    }
+
+    /**
+     * @brief Multiply on up to <threads> threads
+     * @param lhs The first factor
+     * @param rhs The second factor
+     * @param threads Thread budget, at least 1
+     * @return The product
+     */
+    static bigint multiply_on(const bigint &lhs, const bigint &rhs, unsigned threads)
+    {
+        const std::size_t long_size = std::max(lhs.digits.size(), rhs.digits.size());
+        const std::size_t short_size = std::min(lhs.digits.size(), rhs.digits.size());
+        if (threads < 2 || short_size < grain)
+            return lhs * rhs;
+
+        const std::size_t m = long_size / 2;
+        if (2 * short_size <= long_size)
+        {
+            // Unbalanced: split the longer factor, the two products share the shorter one
+            const bigint &longer = lhs.digits.size() >= rhs.digits.size() ? lhs : rhs;
+            const bigint &shorter = lhs.digits.size() >= rhs.digits.size() ? rhs : lhs;
+            bigint high;
+            bigint low;
+            split(longer, m, high, low);
+            std::future<bigint> upper = spawn([&] { return multiply_on(high, shorter, threads / 2); });
+            bigint result = multiply_on(low, shorter, threads - threads / 2);
+            result += upper.get().multiply_pow10(m);
+            return result;
+        }
+
+        // Karatsuba at the top level. From three threads on, the three products run on their own threads. With two, one
+        // product runs on a new thread and the calling thread takes the other two in turn.
+        bigint x1;
+        bigint x0;
+        bigint y1;
+        bigint y0;
+        split(lhs, m, x1, x0);
+        split(rhs, m, y1, y0);
+        const unsigned share = threads / 3;
+        std::future<bigint> z2 = spawn([&] { return multiply_on(x1, y1, std::max(1u, share)); });
+        bigint z1;
+        bigint z0;
+        if (threads >= 3)
+        {
+            std::future<bigint> sum = spawn([&] { return multiply_on(x0 + x1, y0 + y1, share); });
+            z0 = multiply_on(x0, y0, threads - 2 * share);
+            z1 = sum.get();
+        }
+        else
+        {
+            z0 = x0 * y0;
+            z1 = (x0 + x1) * (y0 + y1);
+        }
+        bigint high = z2.get();
+        bigint middle = z1 - z0 - high;
+        bigint result = std::move(high.multiply_pow10(2 * m));
+        result += middle.multiply_pow10(m);
+        result += z0;
+        return result;
+    }
+
+    /**
+     * @brief Parse unsigned digits in a base other than 10 by splitting them into a high and a low part.
+     * The low part has chunk * 2^j chars, so the high part is scaled by powers[j] = base^(chunk * 2^j).
+     * @param text The digits, without a sign
+     * @param base The base
+     * @param powers Powers of the base for each split size, shared read-only by every thread
+     * @param chunk Chars per word of the radix constructor
+     * @param threads Thread budget, at least 1
+     * @return The number
+     */
+    static bigint parse_radix(std::string_view text, int base, const std::vector<bigint> &powers, std::size_t chunk,
+                              unsigned threads)
+    {
+        if (threads < 2 || text.size() < grain)
+            return bigint(text, base);
+
+        std::size_t j = 0;
+        while (chunk << (j + 1) < text.size())
+            j++;
+        const std::size_t low_size = chunk << j;
+        const std::string_view high_text = text.substr(0, text.size() - low_size);
+        const std::string_view low_text = text.substr(text.size() - low_size);
+
+        std::future<bigint> high = spawn([&] { return parse_radix(high_text, base, powers, chunk, threads / 2); });
+        bigint result = parse_radix(low_text, base, powers, chunk, threads - threads / 2);
+        result += multiply_on(high.get(), powers[j], threads);
+        return result;
+    }
+
+    /**
+     * @brief Run <task> on <segments> equal parts of [0, size), all but the first on new threads
+     * @param size Size of the range
+     * @param segments Number of parts, at least 1
+     * @param task Callable taking the begin and end of a part
+     */
+    template <typename Task>
+    static void for_segments(std::size_t size, std::size_t segments, Task task)
+    {
+        std::vector<std::future<void>> parts;
+        for (std::size_t k = 1; k < segments; k++)
+            parts.push_back(spawn([&task, begin = size * k / segments, end = size * (k + 1) / segments]
+                                  { task(begin, end); }));
+        task(std::size_t(0), size / segments);
+        for (std::future<void> &part : parts)
+            part.get(); // Rethrows the exception of a part
+    }
+
+public:
+    /**
+     * @brief Multiply two numbers on several threads. Balanced factors are split for one Karatsuba step per level, with
+     * the three products in parallel. Splitting a number costs no arithmetic, since its digits are decimal.
+     * @param lhs The first factor
+     * @param rhs The second factor
+     * @param threads Number of threads, 0 for every hardware thread
+     * @return The product
+     */
+    static bigint multiply(const bigint &lhs, const bigint &rhs, unsigned threads = 0)
+    {
+        return multiply_on(lhs, rhs, budget(threads));
+    }
+
+    /**
+     * @brief Convert a number to a string on several threads. In base 10, each thread writes its segment of the digits
+     * straight into its final place in the preallocated string. Other bases run the word division passes of
+     * bigint::to_string, which depend on each other and stay on one thread.
+     * @param num The number
+     * @param base The base, from 2 to 36
+     * @param threads Number of threads, 0 for every hardware thread
+     * @return The string
+     */
+    static std::string to_string(const bigint &num, int base = 10, unsigned threads = 0)
+    {
+        const std::size_t size = num.digits.size();
+        const std::size_t segments = std::min<std::size_t>(budget(threads), size / grain);
+        if (base != 10 || segments < 2)
+            return num.to_string(base);
+
+        const std::size_t sign = num.isNegative ? 1 : 0;
+        std::string result(size + sign, '-');
+        for_segments(size, segments,
+                     [&](std::size_t begin, std::size_t end)
+                     {
+                         const std::span<const std::uint8_t> digits(num.digits);
+                         bigint::write_digit_chars(digits.subspan(size - end, end - begin), result.data() + sign + begin);
+                     });
+        return result;
+    }
+
+    /**
+     * @brief Parse a string of digits on several threads, with the same rules and exceptions as the radix constructor.
+     * In base 10, each thread checks its segment of the chars and writes their digits straight into their final place.
+     * Other bases parse the high and low parts of the string on separate threads and join them with a parallel
+     * multiplication by a power of the base.
+     * @param text The string, with an optional sign
+     * @param base The base, from 2 to 36
+     * @param threads Number of threads, 0 for every hardware thread
+     * @return The number
+     */
+    static bigint parse(std::string_view text, int base = 10, unsigned threads = 0)
+    {
+        bigint::check_radix(base);
+        const unsigned total = budget(threads);
+        std::string_view body = text;
+        if (!body.empty() && (body[0] == '-' || body[0] == '+'))
+            body.remove_prefix(1);
+        if (total < 2 || body.size() < 2 * grain)
+            return bigint(text, base);
+
+        bigint result;
+        if (base == 10)
+        {
+            const std::size_t size = body.size();
+            std::vector<std::uint8_t> digits = bigint::scratch_pool::acquire(size);
+            for_segments(size, std::min<std::size_t>(total, size / grain),
+                         [&](std::size_t begin, std::size_t end)
+                         {
+                             for (std::size_t i = begin; i < end; i++)
+                             {
+                                 if (body[i] < '0' || body[i] > '9')
+                                     throw std::invalid_argument("Error: String contains non-digit char.");
+                                 digits[size - 1 - i] = static_cast<std::uint8_t>(body[i] - '0');
+                             }
+                         });
+            bigint::remove_leading_zeros(digits);
+            result.replace_digits(std::move(digits));
+        }
+        else
+        {
+            // The parts are parsed by the radix constructor, which would take a sign char at the start of a part
+            for (char c : body)
+            {
+                if (bigint::radix_digit(c) >= base)
+                    throw std::invalid_argument("Error: String contains non-digit char.");
+            }
+            std::size_t chunk = 0;
+            std::vector<bigint> powers{bigint(static_cast<std::int64_t>(bigint::radix_word(base, chunk)))};
+            while (chunk << powers.size() < body.size())
+                powers.push_back(multiply_on(powers.back(), powers.back(), total));
+            result = parse_radix(body, base, powers, chunk, total);
+        }
+        result.isNegative = text[0] == '-' && !bigint::is_abs_zero(result.digits);
+        return result;
+    }
+};
+
+#endif
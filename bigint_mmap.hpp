@@ -0,0 +1,174 @@
+#ifndef BIGINT_MMAP_HPP
+#define BIGINT_MMAP_HPP
+
+#include "bigint.hpp"
+
+#include <cerrno>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+// POSIX memory mapping
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Read-only memory mapping of a file written by <save_bigint> or <bigint::serialize>.
+ * The mapped number is read through a bigint_view, so a file in the digit image encoding is used as an operand in place,
+ * without being copied into a bigint first.
+ */
+class mapped_bigint
+{
+private:
+    void *address = nullptr;
+    std::size_t length = 0;
+
+    /**
+     * @brief Unmap the file if it is mapped
+     */
+    void unmap()
+    {
+        if (this->address != nullptr)
+            munmap(this->address, this->length);
+        this->address = nullptr;
+        this->length = 0;
+    }
+
+public:
+    /**
+     * @brief Path constructor: Map the whole file read-only and validate its header and every digit or limb, in one
+     * pass, so views of the mapping can go straight into the kernels
+     * @param path Path of the file to be mapped
+     */
+    explicit mapped_bigint(const std::string &path)
+    {
+        // Reference: https://man7.org/linux/man-pages/man2/mmap.2.html
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "Error: Cannot open " + path);
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0)
+        {
+            const int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "Error: Cannot stat " + path);
+        }
+
+        this->length = static_cast<std::size_t>(info.st_size);
+        if (this->length == 0)
+        {
+            close(fd);
+            throw std::invalid_argument("Error: Truncated binary bigint.");
+        }
+
+        this->address = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, fd, 0);
+        const int error = errno;
+        close(fd); // The mapping stays valid after the descriptor is closed
+
+        if (this->address == MAP_FAILED)
+        {
+            this->address = nullptr;
+            throw std::system_error(error, std::generic_category(), "Error: Cannot map " + path);
+        }
+
+        // Kernels walk the digits linearly, so let the kernel read ahead
+        madvise(this->address, this->length, MADV_SEQUENTIAL);
+
+        try
+        {
+            view().validate();
+        }
+        catch (...)
+        {
+            unmap();
+            throw;
+        }
+    }
+
+    mapped_bigint(const mapped_bigint &) = delete;
+    mapped_bigint &operator=(const mapped_bigint &) = delete;
+
+    /**
+     * @brief Move constructor: Take over the mapping of another object
+     * @param other Mapping to be moved from
+     */
+    mapped_bigint(mapped_bigint &&other) noexcept
+        : address(std::exchange(other.address, nullptr)), length(std::exchange(other.length, 0))
+    {
+    }
+
+    /**
+     * @brief Move assignment operator: Unmap the current file and take over the mapping of another object
+     * @param other Mapping to be moved from
+     * @return The current object after assignment
+     */
+    mapped_bigint &operator=(mapped_bigint &&other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            this->address = std::exchange(other.address, nullptr);
+            this->length = std::exchange(other.length, 0);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destructor: Unmap the file
+     */
+    ~mapped_bigint()
+    {
+        unmap();
+    }
+
+    /**
+     * @brief View of the mapped number, valid as long as this object is alive
+     * @return The view
+     */
+    bigint_view view() const
+    {
+        return bigint_view(std::span<const std::byte>(static_cast<const std::byte *>(this->address), this->length));
+    }
+
+    /**
+     * @brief Copy the mapped number into a bigint
+     * @return The mapped number
+     */
+    bigint to_bigint() const
+    {
+        return view().to_bigint();
+    }
+};
+
+/**
+ * @brief Stream a number straight into a file in the binary format
+ * @param path Path of the file, truncated if it exists
+ * @param num Number to be stored
+ * @param encoding Encoding of the payload. The digit image can be mapped and used as an operand without copying.
+ */
+inline void save_bigint(const std::string &path, const bigint &num,
+                        bigint::binary_encoding encoding = bigint::binary_encoding::digits)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::system_error(errno, std::generic_category(), "Error: Cannot open " + path);
+
+    num.serialize(file, encoding);
+    if (!file.flush())
+        throw std::system_error(errno, std::generic_category(), "Error: Cannot write " + path);
+}
+
+/**
+ * @brief Load a number from a file in the binary format through a temporary mapping
+ * @param path Path of the file
+ * @return The stored number
+ */
+inline bigint load_bigint(const std::string &path)
+{
+    return mapped_bigint(path).to_bigint();
+}
+
+#endif
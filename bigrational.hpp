@@ -0,0 +1,380 @@
+#ifndef BIGRATIONAL_HPP
+#define BIGRATIONAL_HPP
+
+#include "bigint.hpp"
+
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief Exact fraction of two bigint numbers with a positive denominator.
+ * Reducing by the GCD is deferred: sums and products of reduced operands stay reduced by dividing out small cross GCDs
+ * first, while unreduced operands are combined with the plain formulas. An unreduced fraction is reduced once its size
+ * grows past a bound, or when <reduce> is called. Const members never write to the fraction, so several threads may read
+ * the same fraction at once: they compare by cross multiplication and reduce a local copy to print or read the parts.
+ */
+class bigrational
+{
+private:
+    bigint num;
+    bigint den;
+    bool reduced = true;
+    std::size_t reduced_size = 2; // Digits of <num> and <den> after the last reduction
+
+    /**
+     * @brief An unreduced fraction is reduced once it has this many more digits than twice its last reduced size
+     */
+    static constexpr std::size_t growth_slack = 64;
+
+    /**
+     * @brief Number of decimal digits of the numerator and the denominator together
+     * @return The digit count
+     */
+    std::size_t size() const
+    {
+        return this->num.size_in_base(10) + this->den.size_in_base(10);
+    }
+
+    /**
+     * @brief Lowest terms of the fraction, without changing it
+     * @param numerator Receives the numerator in lowest terms
+     * @param denominator Receives the denominator in lowest terms
+     */
+    void lowest_terms(bigint &numerator, bigint &denominator) const
+    {
+        numerator = this->num;
+        denominator = this->den;
+        if (this->reduced)
+            return;
+
+        const bigint divisor = bigint::gcd(this->num, this->den);
+        if (divisor != bigint(1))
+        {
+            numerator /= divisor;
+            denominator /= divisor;
+        }
+    }
+
+    /**
+     * @brief Store the result of an operation and reduce it if it has grown past the bound
+     * @param numerator The numerator
+     * @param denominator The positive denominator
+     * @param is_reduced True iff the fraction is known to be in lowest terms
+     */
+    void assign(bigint &&numerator, bigint &&denominator, bool is_reduced)
+    {
+        const std::size_t bound = 2 * this->reduced_size + growth_slack;
+        this->num = std::move(numerator);
+        this->den = std::move(denominator);
+        this->reduced = is_reduced;
+        if (is_reduced || size() > bound)
+            reduce();
+    }
+
+public:
+    /**
+     * @brief Default constructor: Initialize the fraction to 0
+     */
+    bigrational() : num(), den(1)
+    {
+    }
+
+    /**
+     * @brief Integer constructor: Initialize the fraction to an integer
+     * @param value The integer
+     */
+    explicit bigrational(bigint value) : num(std::move(value)), den(1)
+    {
+        this->reduced_size = size();
+    }
+
+    /**
+     * @brief Fraction constructor: Initialize the fraction to numerator / denominator. The fraction is reduced lazily.
+     * @param numerator The numerator
+     * @param denominator The denominator, must not be zero
+     */
+    bigrational(bigint numerator, bigint denominator) : num(std::move(numerator)), den(std::move(denominator))
+    {
+        if (this->den == bigint())
+            throw std::logic_error("Error: Division by zero");
+        if (this->den < bigint())
+        {
+            this->num = -this->num;
+            this->den = -this->den;
+        }
+        this->reduced = this->den == bigint(1);
+        this->reduced_size = this->reduced ? size() : 2;
+    }
+
+    /**
+     * @brief Divide the numerator and the denominator by their GCD now, so later reads of the parts cost no GCD
+     */
+    void reduce()
+    {
+        if (!this->reduced)
+        {
+            lowest_terms(this->num, this->den);
+            this->reduced = true;
+        }
+        this->reduced_size = size();
+    }
+
+    /**
+     * @brief Numerator of the fraction in lowest terms. An unreduced fraction takes a GCD on every call.
+     * @return The numerator, with the sign of the fraction
+     */
+    bigint numerator() const
+    {
+        bigint numerator;
+        bigint denominator;
+        lowest_terms(numerator, denominator);
+        return numerator;
+    }
+
+    /**
+     * @brief Denominator of the fraction in lowest terms. An unreduced fraction takes a GCD on every call.
+     * @return The positive denominator
+     */
+    bigint denominator() const
+    {
+        bigint numerator;
+        bigint denominator;
+        lowest_terms(numerator, denominator);
+        return denominator;
+    }
+
+    /**
+     * @brief Negation Operator: Negate the fraction
+     * @return A new fraction with the opposite sign
+     */
+    bigrational operator-() const
+    {
+        bigrational result = *this;
+        result.num = -result.num;
+        return result;
+    }
+
+    /**
+     * @brief Addition Assignment Operator: Add another fraction to the current fraction.
+     * For reduced operands a/b and c/d with g = gcd(b, d), t = a(d/g) + c(b/g) shares no factor with b/g or d/g, so only
+     * gcd(t, g) is left to divide out.
+     * @param rhs The fraction to be added
+     * @return The current fraction after addition
+     */
+    bigrational &operator+=(const bigrational &rhs)
+    {
+        if (this->den == rhs.den)
+        {
+            assign(this->num + rhs.num, bigint(this->den), this->den == bigint(1));
+            return *this;
+        }
+        if (!this->reduced || !rhs.reduced)
+        {
+            assign(this->num * rhs.den + rhs.num * this->den, this->den * rhs.den, false);
+            return *this;
+        }
+
+        // Reference: Knuth, The Art of Computer Programming, Vol. 2, 4.5.1
+        const bigint g = bigint::gcd(this->den, rhs.den);
+        if (g == bigint(1))
+        {
+            assign(this->num * rhs.den + rhs.num * this->den, this->den * rhs.den, true);
+            return *this;
+        }
+        const bigint lhs_part = this->den / g;
+        const bigint rhs_part = rhs.den / g;
+        bigint t = this->num * rhs_part + rhs.num * lhs_part;
+        const bigint g2 = bigint::gcd(t, g);
+        if (g2 == bigint(1))
+        {
+            assign(std::move(t), lhs_part * rhs.den, true);
+            return *this;
+        }
+        assign(t / g2, lhs_part * (rhs.den / g2), true);
+        return *this;
+    }
+
+    /**
+     * @brief Subtraction Assignment Operator: Subtract another fraction from the current fraction
+     * @param rhs The fraction to be subtracted
+     * @return The current fraction after subtraction
+     */
+    bigrational &operator-=(const bigrational &rhs)
+    {
+        return *this += -rhs;
+    }
+
+    /**
+     * @brief Multiplication Assignment Operator: Multiply the current fraction by another fraction.
+     * For reduced operands, (a/b)(c/d) is in lowest terms after dividing out gcd(a, d) and gcd(c, b), which are taken
+     * of the operands instead of the larger product.
+     * @param rhs The fraction to be multiplied with
+     * @return The current fraction after multiplication
+     */
+    bigrational &operator*=(const bigrational &rhs)
+    {
+        if (!this->reduced || !rhs.reduced)
+        {
+            assign(this->num * rhs.num, this->den * rhs.den, false);
+            return *this;
+        }
+
+        if (this->num == bigint() || rhs.num == bigint())
+        {
+            assign(bigint(), bigint(1), true);
+            return *this;
+        }
+        const bigint g1 = bigint::gcd(this->num, rhs.den);
+        const bigint g2 = bigint::gcd(rhs.num, this->den);
+        assign((this->num / g1) * (rhs.num / g2), (this->den / g2) * (rhs.den / g1), true);
+        return *this;
+    }
+
+    /**
+     * @brief Division Assignment Operator: Divide the current fraction by another fraction
+     * @param rhs The fraction to divide by, must not be zero
+     * @return The current fraction after division
+     */
+    bigrational &operator/=(const bigrational &rhs)
+    {
+        if (rhs.num == bigint())
+            throw std::logic_error("Error: Division by zero");
+
+        // The reciprocal keeps the reduced state of <rhs>
+        bigrational reciprocal = rhs;
+        std::swap(reciprocal.num, reciprocal.den);
+        if (reciprocal.den < bigint())
+        {
+            reciprocal.num = -reciprocal.num;
+            reciprocal.den = -reciprocal.den;
+        }
+        return *this *= reciprocal;
+    }
+
+    /**
+     * @brief Addition Operator: Add two fractions
+     * @param lhs The first fraction
+     * @param rhs The second fraction
+     * @return A new fraction that is the sum
+     */
+    friend bigrational operator+(bigrational lhs, const bigrational &rhs)
+    {
+        return lhs += rhs;
+    }
+
+    /**
+     * @brief Subtraction Operator: Subtract two fractions
+     * @param lhs The fraction to be subtracted from
+     * @param rhs The fraction to be subtracted
+     * @return A new fraction that is the difference
+     */
+    friend bigrational operator-(bigrational lhs, const bigrational &rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    /**
+     * @brief Multiplication Operator: Multiply two fractions
+     * @param lhs The first fraction
+     * @param rhs The second fraction
+     * @return A new fraction that is the product
+     */
+    friend bigrational operator*(bigrational lhs, const bigrational &rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    /**
+     * @brief Division Operator: Divide two fractions
+     * @param lhs The fraction to be divided
+     * @param rhs The fraction to divide by
+     * @return A new fraction that is the quotient
+     */
+    friend bigrational operator/(bigrational lhs, const bigrational &rhs)
+    {
+        return lhs /= rhs;
+    }
+
+    /**
+     * @brief Equality Operator: Compare the parts of reduced fractions directly, and others as a * d == c * b
+     * @param rhs The fraction to be compared with
+     * @return True iff the two fractions are equal
+     */
+    bool operator==(const bigrational &rhs) const
+    {
+        if (this->reduced && rhs.reduced)
+            return this->num == rhs.num && this->den == rhs.den;
+        return this->num * rhs.den == rhs.num * this->den;
+    }
+
+    /**
+     * @brief Inequality Operator: Check if two fractions are not equal
+     * @param rhs The fraction to be compared with
+     * @return True iff the two fractions are not equal
+     */
+    bool operator!=(const bigrational &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @brief Less Than Operator: Compare a/b < c/d as a * d < c * b, since both denominators are positive
+     * @param rhs The fraction to be compared with
+     * @return True iff the current fraction is less than <rhs>
+     */
+    bool operator<(const bigrational &rhs) const
+    {
+        return this->num * rhs.den < rhs.num * this->den;
+    }
+
+    /**
+     * @brief Less Than or Equal To Operator
+     * @param rhs The fraction to be compared with
+     * @return True iff the current fraction is less than or equal to <rhs>
+     */
+    bool operator<=(const bigrational &rhs) const
+    {
+        return !(rhs < *this);
+    }
+
+    /**
+     * @brief Greater Than Operator
+     * @param rhs The fraction to be compared with
+     * @return True iff the current fraction is greater than <rhs>
+     */
+    bool operator>(const bigrational &rhs) const
+    {
+        return rhs < *this;
+    }
+
+    /**
+     * @brief Greater Than or Equal To Operator
+     * @param rhs The fraction to be compared with
+     * @return True iff the current fraction is greater than or equal to <rhs>
+     */
+    bool operator>=(const bigrational &rhs) const
+    {
+        return !(*this < rhs);
+    }
+
+    /**
+     * @brief Insertion Operator: Print the fraction in lowest terms as num/den, or as an integer if den is 1
+     * @param stream The output stream
+     * @param value The fraction to be printed
+     * @return The output stream
+     */
+    friend std::ostream &operator<<(std::ostream &stream, const bigrational &value)
+    {
+        bigint numerator;
+        bigint denominator;
+        value.lowest_terms(numerator, denominator);
+        stream << numerator;
+        if (denominator != bigint(1))
+            stream << '/' << denominator;
+        return stream;
+    }
+};
+
+#endif
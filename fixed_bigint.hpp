@@ -0,0 +1,667 @@
+#ifndef FIXED_BIGINT_HPP
+#define FIXED_BIGINT_HPP
+
+#include "bigint.hpp"
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief What fixed_bigint does when a result does not fit in its width
+ */
+enum class overflow_mode
+{
+    wrap,    // Keep the low bits, like the built-in unsigned integers
+    checked, // Throw std::overflow_error
+};
+
+/**
+ * @brief Signed two's complement integer of a fixed width with its limbs in a std::array.
+ * The limb count is known at compile time, so the add, subtract and multiply kernels are fully unrolled, division
+ * runs Knuth's algorithm D on whole limbs, and no operation allocates.
+ * @tparam Bits Width of the integer, a positive multiple of 64
+ * @tparam Mode Behavior on overflow
+ */
+template <std::size_t Bits, overflow_mode Mode = overflow_mode::wrap>
+class fixed_bigint
+{
+    static_assert(Bits > 0 && Bits % 64 == 0, "fixed_bigint width must be a positive multiple of 64 bits");
+
+private:
+    static constexpr std::size_t limb_count = Bits / 64;
+    using limbs_type = std::array<std::uint64_t, limb_count>;
+
+    limbs_type limbs{}; // Least significant limb first
+
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 u128; // __extension__ keeps -Wpedantic quiet about the GCC/Clang type
+#endif
+
+    /**
+     * @brief Call <f> with the indices 0 to Count - 1 as compile-time constants, so the loop is fully unrolled
+     * @param f Callable taking a std::integral_constant index
+     */
+    template <std::size_t Count, typename F>
+    static constexpr void unrolled(F &&f)
+    {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (f(std::integral_constant<std::size_t, I>{}), ...);
+        }(std::make_index_sequence<Count>{});
+    }
+
+    /**
+     * @brief Multiply two limbs into a double-limb product
+     * @param a The first limb
+     * @param b The second limb
+     * @param high Receives the high limb of the product
+     * @return The low limb of the product
+     */
+    static constexpr std::uint64_t multiply_wide(std::uint64_t a, std::uint64_t b, std::uint64_t &high)
+    {
+#ifdef __SIZEOF_INT128__
+        const u128 product = static_cast<u128>(a) * b;
+        high = static_cast<std::uint64_t>(product >> 64);
+        return static_cast<std::uint64_t>(product);
+#else
+        const std::uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32;
+        const std::uint64_t b_lo = b & 0xffffffff, b_hi = b >> 32;
+        const std::uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+        const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+        high = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+        return (cross << 32) | (lo_lo & 0xffffffff);
+#endif
+    }
+
+    /**
+     * @brief Add two limb arrays
+     * @param lhs The first addend
+     * @param rhs The second addend
+     * @param result Receives the sum modulo 2^Bits
+     * @return The carry out of the top limb
+     */
+    static constexpr std::uint64_t add_limbs(const limbs_type &lhs, const limbs_type &rhs, limbs_type &result)
+    {
+        std::uint64_t carry = 0;
+        unrolled<limb_count>([&](auto i) {
+            const std::uint64_t sum = lhs[i] + carry;
+            carry = sum < carry;
+            result[i] = sum + rhs[i];
+            carry += result[i] < sum;
+        });
+        return carry;
+    }
+
+    /**
+     * @brief Subtract two limb arrays
+     * @param lhs The minuend
+     * @param rhs The subtrahend
+     * @param result Receives the difference modulo 2^Bits
+     * @return The borrow out of the top limb
+     */
+    static constexpr std::uint64_t subtract_limbs(const limbs_type &lhs, const limbs_type &rhs, limbs_type &result)
+    {
+        std::uint64_t borrow = 0;
+        unrolled<limb_count>([&](auto i) {
+            const std::uint64_t diff = lhs[i] - borrow;
+            borrow = diff > lhs[i];
+            result[i] = diff - rhs[i];
+            borrow += result[i] > diff;
+        });
+        return borrow;
+    }
+
+    /**
+     * @brief Multiply two limb arrays
+     * @param lhs The first factor
+     * @param rhs The second factor
+     * @param result Receives the product modulo 2^Bits
+     * @return True iff the full unsigned product does not fit in Bits bits
+     */
+    static constexpr bool multiply_limbs(const limbs_type &lhs, const limbs_type &rhs, limbs_type &result)
+    {
+        std::array<std::uint64_t, 2 * limb_count> product{};
+        unrolled<limb_count>([&](auto i) {
+            std::uint64_t carry = 0;
+            unrolled<limb_count>([&](auto j) {
+                std::uint64_t high;
+                const std::uint64_t low = multiply_wide(lhs[i], rhs[j], high);
+                std::uint64_t sum = product[i + j] + low;
+                high += sum < low;
+                sum += carry;
+                high += sum < carry;
+                product[i + j] = sum;
+                carry = high;
+            });
+            product[i + limb_count] = carry;
+        });
+
+        bool overflow = false;
+        unrolled<limb_count>([&](auto i) {
+            result[i] = product[i];
+            overflow = overflow || product[i + limb_count] != 0;
+        });
+        return overflow;
+    }
+
+#ifdef __SIZEOF_INT128__
+    /**
+     * @brief Divide two unsigned limb arrays by schoolbook long division on limbs (Knuth, TAOCP vol. 2, 4.3.1, D).
+     * The divisor is shifted so its top limb has its high bit set. Each quotient limb is then estimated from the top two
+     * limbs of the remainder with one 128-bit division and is at most one too large after the two-limb correction.
+     * @param dividend The dividend
+     * @param divisor The non-zero divisor
+     * @param quotient Receives the quotient
+     * @param remainder Receives the remainder
+     */
+    static constexpr void divide_limbs(const limbs_type &dividend, const limbs_type &divisor, limbs_type &quotient,
+                                       limbs_type &remainder)
+    {
+        quotient = {};
+        remainder = {};
+
+        std::size_t m = limb_count;
+        while (m > 0 && dividend[m - 1] == 0)
+            m--;
+        std::size_t n = limb_count;
+        while (divisor[n - 1] == 0)
+            n--;
+
+        if (m < n)
+        {
+            remainder = dividend;
+            return;
+        }
+
+        if (n == 1)
+        {
+            // Short division, one 128-bit division per limb
+            u128 rest = 0;
+            for (std::size_t i = m; i > 0; i--)
+            {
+                const u128 current = (rest << 64) | dividend[i - 1];
+                quotient[i - 1] = static_cast<std::uint64_t>(current / divisor[0]);
+                rest = current % divisor[0];
+            }
+            remainder[0] = static_cast<std::uint64_t>(rest);
+            return;
+        }
+
+        // Normalize, the dividend gets an extra top limb for the bits shifted out
+        const int shift = std::countl_zero(divisor[n - 1]);
+        const auto shifted = [shift](std::uint64_t high, std::uint64_t low) {
+            return shift == 0 ? high : (high << shift) | (low >> (64 - shift));
+        };
+        limbs_type v{};
+        for (std::size_t i = n - 1; i > 0; i--)
+            v[i] = shifted(divisor[i], divisor[i - 1]);
+        v[0] = divisor[0] << shift;
+        std::array<std::uint64_t, limb_count + 1> u{};
+        u[m] = shift == 0 ? 0 : dividend[m - 1] >> (64 - shift);
+        for (std::size_t i = m - 1; i > 0; i--)
+            u[i] = shifted(dividend[i], dividend[i - 1]);
+        u[0] = dividend[0] << shift;
+
+        for (std::size_t j = m - n + 1; j-- > 0;)
+        {
+            const u128 top = (static_cast<u128>(u[j + n]) << 64) | u[j + n - 1];
+            u128 estimate = top / v[n - 1];
+            u128 rest = top % v[n - 1];
+            while ((estimate >> 64) != 0 || estimate * v[n - 2] > ((rest << 64) | u[j + n - 2]))
+            {
+                estimate--;
+                rest += v[n - 1];
+                if ((rest >> 64) != 0)
+                    break;
+            }
+
+            // Subtract estimate * v from the window of u
+            const std::uint64_t digit = static_cast<std::uint64_t>(estimate);
+            std::uint64_t carry = 0;
+            std::uint64_t borrow = 0;
+            for (std::size_t i = 0; i < n; i++)
+            {
+                const u128 product = static_cast<u128>(digit) * v[i] + carry;
+                carry = static_cast<std::uint64_t>(product >> 64);
+                const std::uint64_t low = static_cast<std::uint64_t>(product);
+                const std::uint64_t difference = u[i + j] - low;
+                const std::uint64_t next_borrow = (u[i + j] < low) + (difference < borrow);
+                u[i + j] = difference - borrow;
+                borrow = next_borrow;
+            }
+            const std::uint64_t difference = u[j + n] - carry;
+            const bool negative = u[j + n] < carry || difference < borrow;
+            u[j + n] = difference - borrow;
+
+            // The estimate was one too large: add v back once
+            quotient[j] = digit;
+            if (negative)
+            {
+                quotient[j]--;
+                carry = 0;
+                for (std::size_t i = 0; i < n; i++)
+                {
+                    const u128 sum = static_cast<u128>(u[i + j]) + v[i] + carry;
+                    u[i + j] = static_cast<std::uint64_t>(sum);
+                    carry = static_cast<std::uint64_t>(sum >> 64);
+                }
+                u[j + n] += carry;
+            }
+        }
+
+        // Undo the normalization of the remainder
+        for (std::size_t i = 0; i < n; i++)
+            remainder[i] = shift == 0 ? u[i] : (u[i] >> shift) | (u[i + 1] << (64 - shift));
+    }
+#else
+    /**
+     * @brief Divide two unsigned limb arrays by binary long division, for compilers without a 128-bit integer
+     * @param dividend The dividend
+     * @param divisor The non-zero divisor
+     * @param quotient Receives the quotient
+     * @param remainder Receives the remainder
+     */
+    static constexpr void divide_limbs(const limbs_type &dividend, const limbs_type &divisor, limbs_type &quotient,
+                                       limbs_type &remainder)
+    {
+        quotient = {};
+        remainder = {};
+
+        // Skip the leading zero bits of the dividend
+        std::size_t bit = Bits;
+        while (bit > 0 && ((dividend[(bit - 1) / 64] >> ((bit - 1) % 64)) & 1) == 0)
+            bit--;
+
+        for (; bit > 0; bit--)
+        {
+            const std::uint64_t top = remainder[limb_count - 1] >> 63;
+            std::uint64_t carry = (dividend[(bit - 1) / 64] >> ((bit - 1) % 64)) & 1;
+            unrolled<limb_count>([&](auto i) {
+                const std::uint64_t next = remainder[i] >> 63;
+                remainder[i] = (remainder[i] << 1) | carry;
+                carry = next;
+            });
+
+            limbs_type difference{};
+            const std::uint64_t borrow = subtract_limbs(remainder, divisor, difference);
+            if (top != 0 || borrow == 0)
+            {
+                remainder = difference;
+                quotient[(bit - 1) / 64] |= std::uint64_t{1} << ((bit - 1) % 64);
+            }
+        }
+    }
+#endif
+
+    /**
+     * @brief Two's complement negation of a limb array
+     * @param value Limbs to be negated
+     * @return The negated limbs modulo 2^Bits
+     */
+    static constexpr limbs_type negate_limbs(const limbs_type &value)
+    {
+        limbs_type result{};
+        std::uint64_t carry = 1;
+        unrolled<limb_count>([&](auto i) {
+            result[i] = ~value[i] + carry;
+            carry = carry && result[i] == 0;
+        });
+        return result;
+    }
+
+    /**
+     * @brief Check the sign bit
+     * @param value Limbs to be checked
+     * @return True iff the two's complement value is negative
+     */
+    static constexpr bool is_negative_limbs(const limbs_type &value)
+    {
+        return (value[limb_count - 1] >> 63) != 0;
+    }
+
+    /**
+     * @brief Absolute value as unsigned limbs, exact even for the minimum value
+     * @param value Limbs to be converted
+     * @return The magnitude
+     */
+    static constexpr limbs_type magnitude(const limbs_type &value)
+    {
+        return is_negative_limbs(value) ? negate_limbs(value) : value;
+    }
+
+    /**
+     * @brief Throw if the mode is checked and an operation overflowed
+     * @param overflow True iff the operation overflowed
+     */
+    static constexpr void report_overflow(bool overflow)
+    {
+        if constexpr (Mode == overflow_mode::checked)
+        {
+            if (overflow)
+                throw std::overflow_error("Error: fixed_bigint overflow");
+        }
+    }
+
+public:
+    /**
+     * @brief Default constructor: Initialize the number to zero
+     */
+    constexpr fixed_bigint() = default;
+
+    /**
+     * @brief Int64 constructor: Initialize the number to the given integer with sign extension
+     * @param num Integer to be converted
+     */
+    constexpr explicit fixed_bigint(std::int64_t num)
+    {
+        this->limbs.fill(num < 0 ? ~std::uint64_t{0} : 0);
+        this->limbs[0] = static_cast<std::uint64_t>(num);
+    }
+
+    /**
+     * @brief Bigint constructor: Convert an arbitrary precision number, wrapping or throwing if it does not fit
+     * @param num Number to be converted
+     */
+    explicit fixed_bigint(const bigint &num)
+    {
+        const std::vector<std::byte> bytes = num.to_bytes(std::endian::little);
+        bool overflow = bytes.size() > Bits / 8;
+
+        for (std::size_t i = 0; i < bytes.size() && i < Bits / 8; i++)
+            this->limbs[i / 8] |= std::to_integer<std::uint64_t>(bytes[i]) << (8 * (i % 8));
+
+        // The magnitude of a negative number may reach 2^(Bits - 1), a positive one must stay below it
+        const bool negative = num < bigint();
+        if (negative)
+            this->limbs = negate_limbs(this->limbs);
+        if (!overflow && (is_negative_limbs(this->limbs) != negative) && *this != fixed_bigint())
+            overflow = true;
+        report_overflow(overflow);
+    }
+
+    /**
+     * @brief Convert to an arbitrary precision number, always lossless
+     * @return The same value as a bigint
+     */
+    bigint to_bigint() const
+    {
+        const limbs_type mag = magnitude(this->limbs);
+        std::array<std::byte, Bits / 8> bytes{};
+        for (std::size_t i = 0; i < bytes.size(); i++)
+            bytes[i] = static_cast<std::byte>(mag[i / 8] >> (8 * (i % 8)));
+
+        const bigint result = bigint::from_bytes(bytes, std::endian::little);
+        return is_negative_limbs(this->limbs) ? -result : result;
+    }
+
+    /**
+     * @brief Read one limb of the two's complement representation
+     * @param index Index of the limb, 0 is the least significant one
+     * @return The limb
+     */
+    constexpr std::uint64_t limb(std::size_t index) const
+    {
+        return this->limbs[index];
+    }
+
+    /**
+     * @brief Negation operator: transform the current number to its negation
+     * @return The negation of the current number
+     */
+    constexpr fixed_bigint operator-() const
+    {
+        fixed_bigint result;
+        result.limbs = negate_limbs(this->limbs);
+        // Only the minimum value is its own negation besides zero
+        report_overflow(is_negative_limbs(this->limbs) && is_negative_limbs(result.limbs));
+        return result;
+    }
+
+    /**
+     * @brief Increment operator (prefix): Add 1 to the current number
+     * @return The incremented number
+     */
+    constexpr fixed_bigint &operator++()
+    {
+        return *this += fixed_bigint(1);
+    }
+
+    /**
+     * @brief Increment operator (postfix): Add 1 to the current number
+     * @return The original number before increment
+     */
+    constexpr fixed_bigint operator++(int)
+    {
+        const fixed_bigint temp = *this;
+        *this += fixed_bigint(1);
+        return temp;
+    }
+
+    /**
+     * @brief Decrement operator (prefix): Subtract 1 from the current number
+     * @return The decremented number
+     */
+    constexpr fixed_bigint &operator--()
+    {
+        return *this -= fixed_bigint(1);
+    }
+
+    /**
+     * @brief Decrement operator (postfix): Subtract 1 from the current number
+     * @return The original number before decrement
+     */
+    constexpr fixed_bigint operator--(int)
+    {
+        const fixed_bigint temp = *this;
+        *this -= fixed_bigint(1);
+        return temp;
+    }
+
+    /**
+     * @brief Addition Assignment Operator: Add <rhs> to the current number
+     * @param rhs Number to be added to the current number
+     * @return The current number after addition
+     */
+    constexpr fixed_bigint &operator+=(const fixed_bigint &rhs)
+    {
+        const bool lhs_negative = is_negative_limbs(this->limbs);
+        add_limbs(this->limbs, rhs.limbs, this->limbs);
+        // Signed overflow: both operands have the same sign and the sum has the other one
+        report_overflow(lhs_negative == is_negative_limbs(rhs.limbs) && lhs_negative != is_negative_limbs(this->limbs));
+        return *this;
+    }
+
+    /**
+     * @brief Subtraction Assignment Operator: Subtract another number from the current number
+     * @param rhs Number to be subtracted from the current number
+     * @return The current number after subtraction
+     */
+    constexpr fixed_bigint &operator-=(const fixed_bigint &rhs)
+    {
+        const bool lhs_negative = is_negative_limbs(this->limbs);
+        subtract_limbs(this->limbs, rhs.limbs, this->limbs);
+        // Signed overflow: the operands have different signs and the difference has the sign of <rhs>
+        report_overflow(lhs_negative != is_negative_limbs(rhs.limbs) && lhs_negative != is_negative_limbs(this->limbs));
+        return *this;
+    }
+
+    /**
+     * @brief Multiplication Assignment Operator: Multiply another number to the current number
+     * @param rhs Number to be multiplied to the current number
+     * @return The current number after multiplication
+     */
+    constexpr fixed_bigint &operator*=(const fixed_bigint &rhs)
+    {
+        if constexpr (Mode == overflow_mode::checked)
+        {
+            const bool negative = is_negative_limbs(this->limbs) != is_negative_limbs(rhs.limbs);
+            limbs_type product{};
+            bool overflow = multiply_limbs(magnitude(this->limbs), magnitude(rhs.limbs), product);
+
+            // The magnitude must stay below 2^(Bits - 1), or reach it exactly for a negative result
+            if (!overflow && is_negative_limbs(product))
+                overflow = !negative || negate_limbs(product) != product;
+            report_overflow(overflow);
+            this->limbs = negative ? negate_limbs(product) : product;
+        }
+        else
+        {
+            // The low half of the product is the same for two's complement and unsigned operands
+            multiply_limbs(this->limbs, rhs.limbs, this->limbs);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Division Assignment Operator: Divide the current number by another number, truncating toward zero
+     * @param rhs Number to divide the current number by
+     * @return The current number after division
+     */
+    constexpr fixed_bigint &operator/=(const fixed_bigint &rhs)
+    {
+        fixed_bigint remainder;
+        divmod(*this, rhs, *this, remainder);
+        return *this;
+    }
+
+    /**
+     * @brief Modulo Assignment Operator: Replace the current number by the remainder of the division by another number
+     * @param rhs Number to divide the current number by
+     * @return The remainder, with the sign of the dividend
+     */
+    constexpr fixed_bigint &operator%=(const fixed_bigint &rhs)
+    {
+        fixed_bigint quotient;
+        divmod(*this, rhs, quotient, *this);
+        return *this;
+    }
+
+    /**
+     * @brief Divide two numbers and get the quotient and the remainder in one pass
+     * @param dividend The number to be divided
+     * @param divisor The number to divide by
+     * @param quotient Receives the quotient, truncated toward zero
+     * @param remainder Receives the remainder, with the sign of the dividend
+     */
+    static constexpr void divmod(const fixed_bigint &dividend, const fixed_bigint &divisor, fixed_bigint &quotient,
+                                 fixed_bigint &remainder)
+    {
+        if (divisor == fixed_bigint())
+            throw std::logic_error("Error: Division by zero");
+
+        const bool dividend_negative = is_negative_limbs(dividend.limbs);
+        const bool quotient_negative = dividend_negative != is_negative_limbs(divisor.limbs);
+
+        limbs_type q{};
+        limbs_type r{};
+        divide_limbs(magnitude(dividend.limbs), magnitude(divisor.limbs), q, r);
+
+        // Only the minimum value divided by -1 overflows
+        report_overflow(!quotient_negative && is_negative_limbs(q));
+        quotient.limbs = quotient_negative ? negate_limbs(q) : q;
+        remainder.limbs = dividend_negative ? negate_limbs(r) : r;
+    }
+
+    /**
+     * @brief Addition Operator: Add two numbers
+     * @param lhs The first number to be added
+     * @param rhs The second number to be added
+     * @return A new number that is the sum of the two numbers
+     */
+    friend constexpr fixed_bigint operator+(fixed_bigint lhs, const fixed_bigint &rhs)
+    {
+        return lhs += rhs;
+    }
+
+    /**
+     * @brief Subtraction Operator: Subtract two numbers
+     * @param lhs The number to be subtracted from
+     * @param rhs The number to be subtracted
+     * @return A new number that is the difference of the two numbers
+     */
+    friend constexpr fixed_bigint operator-(fixed_bigint lhs, const fixed_bigint &rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    /**
+     * @brief Multiplication Operator: Multiply two numbers
+     * @param lhs The first number to be multiplied
+     * @param rhs The second number to be multiplied
+     * @return A new number that is the product of the two numbers
+     */
+    friend constexpr fixed_bigint operator*(fixed_bigint lhs, const fixed_bigint &rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    /**
+     * @brief Division Operator: Divide two numbers
+     * @param lhs The number to be divided
+     * @param rhs The number to divide by
+     * @return A new number that is the quotient of the two numbers
+     */
+    friend constexpr fixed_bigint operator/(fixed_bigint lhs, const fixed_bigint &rhs)
+    {
+        return lhs /= rhs;
+    }
+
+    /**
+     * @brief Modulo Operator: Remainder of the division of two numbers
+     * @param lhs The number to be divided
+     * @param rhs The number to divide by
+     * @return A new number that is the remainder, with the sign of <lhs>
+     */
+    friend constexpr fixed_bigint operator%(fixed_bigint lhs, const fixed_bigint &rhs)
+    {
+        return lhs %= rhs;
+    }
+
+    /**
+     * @brief Equality Operator: Check if two numbers are equal
+     * @param rhs The number to be compared with
+     * @return True iff the two numbers are equal
+     */
+    constexpr bool operator==(const fixed_bigint &rhs) const = default;
+
+    /**
+     * @brief Three-way Comparison Operator: Compare two numbers, also provides <, <=, > and >=
+     * @param rhs The number to be compared with
+     * @return The ordering of the current number relative to <rhs>
+     */
+    constexpr std::strong_ordering operator<=>(const fixed_bigint &rhs) const
+    {
+        const bool lhs_negative = is_negative_limbs(this->limbs);
+        if (lhs_negative != is_negative_limbs(rhs.limbs))
+            return lhs_negative ? std::strong_ordering::less : std::strong_ordering::greater;
+
+        // Two's complement numbers of the same sign are ordered like their unsigned limbs
+        for (std::size_t i = limb_count; i > 0; i--)
+        {
+            if (this->limbs[i - 1] != rhs.limbs[i - 1])
+                return this->limbs[i - 1] < rhs.limbs[i - 1] ? std::strong_ordering::less : std::strong_ordering::greater;
+        }
+        return std::strong_ordering::equal;
+    }
+
+    /**
+     * @brief Insertion Operator: Send the number to the output stream in decimal
+     * @param stream Output stream to send the number
+     * @param num Number to be sent
+     * @return The output stream after sending the number
+     */
+    friend std::ostream &operator<<(std::ostream &stream, const fixed_bigint &num)
+    {
+        return stream << num.to_bigint();
+    }
+};
+
+using int256 = fixed_bigint<256>;
+using int512 = fixed_bigint<512>;
+
+#endif
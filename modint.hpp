@@ -0,0 +1,772 @@
+#ifndef MODINT_HPP
+#define MODINT_HPP
+
+#include "bigint.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Immutable modulus with precomputed Montgomery constants, shared by every modint of that modulus.
+ * bigint stores decimal digits, so the Montgomery radix is R = 10^k with k the number of digits of the modulus: reducing
+ * modulo R keeps the k lowest digits and dividing by R drops them, and a product is reduced without a long division.
+ * This needs a modulus coprime to 10. Other moduli fall back to operator% after each product.
+ */
+class modint_context
+{
+private:
+    bigint modulus;
+    std::size_t radix_digits = 0; // k, with R = 10^k > modulus
+    bool montgomery = false;      // True iff the modulus is coprime to 10
+    bigint modulus_neg_inverse;   // -modulus^-1 mod R
+    bigint one;                   // R mod modulus, the Montgomery form of 1
+
+    /**
+     * @brief Montgomery reduction: t * R^-1 mod modulus
+     * @param t A number in [0, modulus * R)
+     * @return The reduced number in [0, modulus)
+     */
+    bigint redc(bigint t) const
+    {
+        // Reference: https://en.wikipedia.org/wiki/Montgomery_modular_multiplication
+        bigint m = t;
+        m.modulo_pow10(this->radix_digits);
+        m *= this->modulus_neg_inverse;
+        m.modulo_pow10(this->radix_digits);
+        t += m * this->modulus; // Divisible by R
+        t.divide_pow10(this->radix_digits);
+        if (t >= this->modulus)
+            t -= this->modulus;
+        return t;
+    }
+
+    friend class modint;
+
+public:
+    /**
+     * @brief Modulus constructor: Precompute the constants. Throws an invalid_argument exception if the modulus is not
+     * positive. Use <create> to share the context between values.
+     * @param modulus The modulus
+     */
+    explicit modint_context(bigint modulus) : modulus(std::move(modulus))
+    {
+        if (this->modulus <= bigint())
+            throw std::invalid_argument("Error: Modulus must be positive.");
+
+        this->radix_digits = this->modulus.size_in_base(10);
+        const bigint lowest = bigint(this->modulus).modulo_pow10(1);
+        this->montgomery = lowest == bigint(1) || lowest == bigint(3) || lowest == bigint(7) || lowest == bigint(9);
+        if (!this->montgomery)
+            return;
+
+        // Hensel lifting: if modulus * x = 1 (mod 10^j), then x * (2 - modulus * x) is the inverse modulo 10^2j
+        static constexpr int digit_inverse[10]{0, 1, 0, 7, 0, 0, 0, 3, 0, 9};
+        bigint inverse(digit_inverse[lowest.to_int64()]);
+        for (std::size_t precision = 1; precision < this->radix_digits;)
+        {
+            precision = std::min(2 * precision, this->radix_digits);
+            bigint correction = this->modulus * inverse;
+            correction.modulo_pow10(precision);
+            inverse *= bigint(2) - correction;
+            inverse.modulo_pow10(precision);
+            if (inverse < bigint())
+                inverse += bigint(1).multiply_pow10(precision);
+        }
+        this->modulus_neg_inverse = bigint(1).multiply_pow10(this->radix_digits) - inverse;
+        this->one = bigint(1).multiply_pow10(this->radix_digits) % this->modulus;
+    }
+
+    /**
+     * @brief Create a context that modint values can share
+     * @param modulus The modulus, must be positive
+     * @return Shared pointer to the context
+     */
+    static std::shared_ptr<const modint_context> create(bigint modulus)
+    {
+        return std::make_shared<const modint_context>(std::move(modulus));
+    }
+
+    /**
+     * @brief The modulus
+     * @return The modulus
+     */
+    const bigint &get_modulus() const
+    {
+        return this->modulus;
+    }
+
+    /**
+     * @brief Check if products are reduced with Montgomery reduction
+     * @return True iff the modulus is coprime to 10
+     */
+    bool uses_montgomery() const
+    {
+        return this->montgomery;
+    }
+
+    /**
+     * @brief Least non-negative remainder of a number
+     * @param num The number to be reduced
+     * @return <num> modulo the modulus in [0, modulus)
+     */
+    bigint reduce(const bigint &num) const
+    {
+        bigint remainder = num % this->modulus;
+        if (remainder < bigint())
+            remainder += this->modulus;
+        return remainder;
+    }
+
+    /**
+     * @brief Bring a reduced number into the internal form, num * R mod modulus for a Montgomery context
+     * @param num A number in [0, modulus)
+     * @return The internal form
+     */
+    bigint to_form(bigint num) const
+    {
+        if (!this->montgomery)
+            return num;
+        num.multiply_pow10(this->radix_digits);
+        return num % this->modulus;
+    }
+
+    /**
+     * @brief Convert a number out of the internal form
+     * @param form The internal form
+     * @return The number in [0, modulus)
+     */
+    bigint from_form(const bigint &form) const
+    {
+        return this->montgomery ? redc(form) : form;
+    }
+
+    /**
+     * @brief Multiply two numbers in the internal form
+     * @param lhs The first factor
+     * @param rhs The second factor
+     * @return The product in the internal form
+     */
+    bigint multiply(const bigint &lhs, const bigint &rhs) const
+    {
+        return this->montgomery ? redc(lhs * rhs) : (lhs * rhs) % this->modulus;
+    }
+};
+
+/**
+ * @brief Residue modulo the modulus of a shared modint_context.
+ * Values stay in the internal form of the context across operations, so a product costs a Montgomery reduction instead
+ * of a long division. They are converted out only by value() and for printing. Operands must share the same modulus.
+ */
+class modint
+{
+private:
+    std::shared_ptr<const modint_context> context;
+    bigint form; // Internal form in [0, modulus)
+
+    /**
+     * @brief Check that another value has the same modulus. Throws an invalid_argument exception otherwise.
+     * @param rhs The other value
+     */
+    void check_context(const modint &rhs) const
+    {
+        if (this->context != rhs.context && this->context->modulus != rhs.context->modulus)
+            throw std::invalid_argument("Error: modint operands have different moduli.");
+    }
+
+public:
+    /**
+     * @brief Value constructor: Reduce a number modulo the modulus of a context
+     * @param context The shared context
+     * @param value The number, may be negative or larger than the modulus
+     */
+    modint(std::shared_ptr<const modint_context> context, const bigint &value) : context(std::move(context))
+    {
+        if (this->context == nullptr)
+            throw std::invalid_argument("Error: modint needs a context.");
+        this->form = this->context->to_form(this->context->reduce(value));
+    }
+
+    /**
+     * @brief The number in [0, modulus), converted out of the internal form
+     * @return The number
+     */
+    bigint value() const
+    {
+        return this->context->from_form(this->form);
+    }
+
+    /**
+     * @brief The shared context
+     * @return Shared pointer to the context
+     */
+    const std::shared_ptr<const modint_context> &get_context() const
+    {
+        return this->context;
+    }
+
+    /**
+     * @brief Negation Operator
+     * @return The additive inverse
+     */
+    modint operator-() const
+    {
+        modint result = *this;
+        if (result.form != bigint())
+            result.form = this->context->modulus - result.form;
+        return result;
+    }
+
+    /**
+     * @brief Addition Assignment Operator. Both forms are linear, so they are added directly.
+     * @param rhs The value to be added
+     * @return The current value after addition
+     */
+    modint &operator+=(const modint &rhs)
+    {
+        check_context(rhs);
+        this->form += rhs.form;
+        if (this->form >= this->context->modulus)
+            this->form -= this->context->modulus;
+        return *this;
+    }
+
+    /**
+     * @brief Subtraction Assignment Operator
+     * @param rhs The value to be subtracted
+     * @return The current value after subtraction
+     */
+    modint &operator-=(const modint &rhs)
+    {
+        check_context(rhs);
+        this->form -= rhs.form;
+        if (this->form < bigint())
+            this->form += this->context->modulus;
+        return *this;
+    }
+
+    /**
+     * @brief Multiplication Assignment Operator: Multiply and reduce without a long division for a Montgomery context
+     * @param rhs The value to be multiplied with
+     * @return The current value after multiplication
+     */
+    modint &operator*=(const modint &rhs)
+    {
+        check_context(rhs);
+        this->form = this->context->multiply(this->form, rhs.form);
+        return *this;
+    }
+
+    /**
+     * @brief Raise the value to a non-negative power, one decimal digit of the exponent at a time.
+     * The powers 0 to 9 of the value are computed once, then each digit of the exponent costs four products for the
+     * tenth power of the accumulated result and one product by a table entry.
+     * @param exponent The exponent, must not be negative
+     * @return The power
+     */
+    modint pow(const bigint &exponent) const
+    {
+        if (exponent < bigint())
+            throw std::invalid_argument("Error: Negative exponent.");
+
+        // The internal form of 1 is R mod modulus for a Montgomery context
+        const bigint one = this->context->montgomery ? this->context->one : this->context->reduce(bigint(1));
+        std::vector<bigint> table{one, this->form};
+        for (int d = 2; d < 10; d++)
+            table.push_back(this->context->multiply(table.back(), this->form));
+
+        modint result = *this;
+        result.form = one;
+        const std::string digits = exponent.to_string();
+        for (const char c : digits)
+        {
+            // result = result^10 * value^d, with result^10 = ((result^2)^2 * result)^2
+            const bigint square = this->context->multiply(result.form, result.form);
+            const bigint fourth = this->context->multiply(square, square);
+            const bigint fifth = this->context->multiply(fourth, result.form);
+            result.form = this->context->multiply(fifth, fifth);
+            if (c != '0')
+                result.form = this->context->multiply(result.form, table[static_cast<std::size_t>(c - '0')]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Multiplicative inverse with the extended Euclidean algorithm. Throws an invalid_argument exception if the
+     * value and the modulus are not coprime.
+     * @return The inverse
+     */
+    modint inverse() const
+    {
+        // Reference: https://en.wikipedia.org/wiki/Extended_Euclidean_algorithm
+        bigint old_r = value(), r = this->context->modulus;
+        bigint old_s(1), s;
+        while (r != bigint())
+        {
+            const bigint q = old_r / r;
+            old_r = std::exchange(r, old_r - q * r);
+            old_s = std::exchange(s, old_s - q * s);
+        }
+        if (old_r != bigint(1) && this->context->modulus != bigint(1))
+            throw std::invalid_argument("Error: Number is not invertible modulo the modulus.");
+        return modint(this->context, old_s);
+    }
+
+    /**
+     * @brief Addition Operator
+     * @param lhs The first value
+     * @param rhs The second value
+     * @return A new value that is the sum
+     */
+    friend modint operator+(modint lhs, const modint &rhs)
+    {
+        return lhs += rhs;
+    }
+
+    /**
+     * @brief Subtraction Operator
+     * @param lhs The value to be subtracted from
+     * @param rhs The value to be subtracted
+     * @return A new value that is the difference
+     */
+    friend modint operator-(modint lhs, const modint &rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    /**
+     * @brief Multiplication Operator
+     * @param lhs The first value
+     * @param rhs The second value
+     * @return A new value that is the product
+     */
+    friend modint operator*(modint lhs, const modint &rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    /**
+     * @brief Equality Operator: The internal form is one-to-one, so it is compared without converting out
+     * @param rhs The value to be compared with
+     * @return True iff the two residues are equal
+     */
+    bool operator==(const modint &rhs) const
+    {
+        check_context(rhs);
+        return this->form == rhs.form;
+    }
+
+    /**
+     * @brief Inequality Operator
+     * @param rhs The value to be compared with
+     * @return True iff the two residues are not equal
+     */
+    bool operator!=(const modint &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @brief Insertion Operator: Send the residue in [0, modulus) to the output stream
+     * @param stream Output stream to send the value
+     * @param num Value to be sent
+     * @return The output stream after sending the value
+     */
+    friend std::ostream &operator<<(std::ostream &stream, const modint &num)
+    {
+        return stream << num.value();
+    }
+};
+
+/**
+ * @brief Raise a number to a power modulo a modulus with the Montgomery form of modint
+ * @param base The base, may be negative
+ * @param exponent The exponent, must not be negative
+ * @param modulus The modulus, must be positive
+ * @return base^exponent mod modulus in [0, modulus)
+ */
+inline bigint powmod(const bigint &base, const bigint &exponent, const bigint &modulus)
+{
+    return modint(modint_context::create(modulus), base).pow(exponent).value();
+}
+
+/**
+ * @brief Odd primes below 2048, multiplied into groups of a few primes below 2^32.
+ * The remainders of a number by all the groups are taken in one pass over its digits, nine digits at a time, so the
+ * number is divided by the whole product of the primes once instead of once per prime.
+ */
+class bigint_sieve
+{
+private:
+    static constexpr std::uint32_t limit = 2048;
+
+    struct group
+    {
+        std::uint64_t product; // Product of primes[first, last), below 2^32
+        std::size_t first;
+        std::size_t last;
+    };
+
+    /**
+     * @brief The groups of the primes, built on first use
+     * @return The groups, in the order of the primes
+     */
+    static const std::vector<group> &groups()
+    {
+        static const std::vector<group> table = []
+        {
+            std::vector<group> result;
+            const std::vector<std::uint32_t> &list = primes();
+            for (std::size_t i = 0; i < list.size(); i++)
+            {
+                if (result.empty() || result.back().product * list[i] >= (std::uint64_t(1) << 32))
+                    result.push_back({1, i, i});
+                result.back().product *= list[i];
+                result.back().last = i + 1;
+            }
+            return result;
+        }();
+        return table;
+    }
+
+public:
+    /**
+     * @brief The odd primes below 2048, found once with the sieve of Eratosthenes
+     * @return The primes in increasing order
+     */
+    static const std::vector<std::uint32_t> &primes()
+    {
+        static const std::vector<std::uint32_t> table = []
+        {
+            std::vector<bool> composite(limit, false);
+            std::vector<std::uint32_t> result;
+            for (std::uint32_t p = 3; p < limit; p += 2)
+            {
+                if (composite[p])
+                    continue;
+                result.push_back(p);
+                for (std::uint32_t multiple = p * p; multiple < limit; multiple += 2 * p)
+                    composite[multiple] = true;
+            }
+            return result;
+        }();
+        return table;
+    }
+
+    /**
+     * @brief Remainders of the absolute value of a number by every prime of <primes>
+     * @param num The number
+     * @return The remainders, in the order of the primes
+     */
+    static std::vector<std::uint32_t> residues(const bigint &num)
+    {
+        const std::vector<group> &table = groups();
+        std::vector<std::uint64_t> remainders(table.size(), 0);
+
+        // Horner's rule from the most significant digit. A remainder is below 2^32 and a chunk below 10^9, so
+        // remainder * 10^9 + chunk fits in 64 bits.
+        const std::vector<std::uint8_t> &digits = num.digits;
+        std::size_t i = digits.size();
+        while (i > 0)
+        {
+            const std::size_t length = (i - 1) % 9 + 1;
+            std::uint64_t chunk = 0;
+            std::uint64_t scale = 1;
+            for (std::size_t j = 0; j < length; j++, i--)
+            {
+                chunk = chunk * 10 + digits[i - 1];
+                scale *= 10;
+            }
+            for (std::size_t k = 0; k < table.size(); k++)
+                remainders[k] = (remainders[k] * scale + chunk) % table[k].product;
+        }
+
+        std::vector<std::uint32_t> result(primes().size());
+        for (std::size_t k = 0; k < table.size(); k++)
+        {
+            for (std::size_t j = table[k].first; j < table[k].last; j++)
+                result[j] = static_cast<std::uint32_t>(remainders[k] % primes()[j]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Largest number whose primality is settled by trial division alone
+     * @return 2048^2 - 1
+     */
+    static constexpr std::uint64_t trial_division_bound()
+    {
+        return std::uint64_t(limit) * limit - 1;
+    }
+};
+
+/**
+ * @brief Probable prime tests used by is_probable_prime and next_prime.
+ * Reference: Baillie and Wagstaff, Lucas Pseudoprimes, Mathematics of Computation 35 (1980)
+ */
+class bigint_primality
+{
+private:
+    /**
+     * @brief Jacobi symbol of two words
+     * @param a The numerator
+     * @param n The odd positive denominator
+     * @return -1, 0 or 1
+     */
+    static int jacobi(std::uint64_t a, std::uint64_t n)
+    {
+        // Reference: https://en.wikipedia.org/wiki/Jacobi_symbol#Calculating_the_Jacobi_symbol
+        int result = 1;
+        a %= n;
+        while (a != 0)
+        {
+            while (a % 2 == 0)
+            {
+                a /= 2;
+                if (n % 8 == 3 || n % 8 == 5)
+                    result = -result;
+            }
+            std::swap(a, n);
+            if (a % 4 == 3 && n % 4 == 3)
+                result = -result;
+            a %= n;
+        }
+        return n == 1 ? result : 0;
+    }
+
+    /**
+     * @brief Jacobi symbol of a small number over a large odd number
+     * @param a The numerator, with |a| below <n>
+     * @param n The odd positive denominator
+     * @return -1, 0 or 1
+     */
+    static int jacobi(std::int64_t a, const bigint &n)
+    {
+        const std::uint64_t n_mod_8 = (n % bigint(8)).to_uint64();
+        int result = 1;
+        std::uint64_t magnitude = static_cast<std::uint64_t>(a < 0 ? -a : a);
+        if (a < 0 && n_mod_8 % 4 == 3)
+            result = -result;
+        while (magnitude != 0 && magnitude % 2 == 0)
+        {
+            magnitude /= 2;
+            if (n_mod_8 == 3 || n_mod_8 == 5)
+                result = -result;
+        }
+        if (magnitude <= 1)
+            return magnitude == 1 ? result : 0;
+
+        // Quadratic reciprocity swaps the two, and the rest is on words
+        if (magnitude % 4 == 3 && n_mod_8 % 4 == 3)
+            result = -result;
+        const std::uint64_t n_mod_a = (n % bigint(static_cast<std::int64_t>(magnitude))).to_uint64();
+        return result * jacobi(n_mod_a, magnitude);
+    }
+
+    /**
+     * @brief Check if a number is a perfect square with Newton's method
+     * @param n The positive number
+     * @return True iff n = x^2 for an integer x
+     */
+    static bool is_square(const bigint &n)
+    {
+        // Start above the root, so the iteration decreases to floor(sqrt(n))
+        bigint x = bigint(1).multiply_pow10((n.size_in_base(10) + 1) / 2);
+        while (true)
+        {
+            bigint y = (x + n / x) / bigint(2);
+            if (y >= x)
+                break;
+            x = std::move(y);
+        }
+        return x * x == n;
+    }
+
+public:
+    /**
+     * @brief Strong probable prime test to one base
+     * @param n The odd number to be tested, greater than 3
+     * @param base The base, in [2, n - 2]
+     * @return False iff <base> proves <n> composite
+     */
+    static bool miller_rabin(const bigint &n, const bigint &base)
+    {
+        // Reference: https://en.wikipedia.org/wiki/Miller%E2%80%93Rabin_primality_test
+        const std::shared_ptr<const modint_context> context = modint_context::create(n);
+        const bigint n_minus_one = n - bigint(1);
+        bigint d = n_minus_one;
+        std::size_t s = 0;
+        while ((d % bigint(2)) == bigint())
+        {
+            d /= bigint(2);
+            s++;
+        }
+
+        const modint one(context, bigint(1));
+        const modint minus_one(context, n_minus_one);
+        modint x = modint(context, base).pow(d);
+        if (x == one || x == minus_one)
+            return true;
+        for (std::size_t r = 1; r < s; r++)
+        {
+            x *= x;
+            if (x == minus_one)
+                return true;
+            if (x == one)
+                return false;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Strong Lucas probable prime test with the parameters of Selfridge's method A
+     * @param n The odd number to be tested, without prime factors below 2048
+     * @return False iff <n> is proven composite
+     */
+    static bool strong_lucas(const bigint &n)
+    {
+        // Reference: https://en.wikipedia.org/wiki/Lucas_pseudoprime#Strong_Lucas_pseudoprimes
+        // D is the first of 5, -7, 9, -11, ... with (D/n) = -1. A perfect square has no such D, so it is ruled out
+        // once a few have failed.
+        std::int64_t d_value = 5;
+        for (int attempt = 0;; attempt++)
+        {
+            const int symbol = jacobi(d_value, n);
+            if (symbol == -1)
+                break;
+            if (symbol == 0)
+                return false; // |D| < 2048 shares a factor with n
+            if (attempt == 8 && is_square(n))
+                return false;
+            d_value = d_value > 0 ? -(d_value + 2) : -d_value + 2;
+        }
+
+        const std::shared_ptr<const modint_context> context = modint_context::create(n);
+        const modint d(context, bigint(d_value));
+        const modint q(context, bigint((1 - d_value) / 4));
+        const modint half(context, (n + bigint(1)) / bigint(2)); // Inverse of 2
+        const modint zero(context, bigint());
+
+        bigint k = n + bigint(1);
+        std::size_t s = 0;
+        while ((k % bigint(2)) == bigint())
+        {
+            k /= bigint(2);
+            s++;
+        }
+
+        // U_1 = 1, V_1 = P = 1, then double the index for each bit of k and add one for each set bit
+        const std::string bits = k.to_string(2);
+        modint u(context, bigint(1));
+        modint v(context, bigint(1));
+        modint q_power = q;
+        for (std::size_t i = 1; i < bits.size(); i++)
+        {
+            u *= v;
+            v = v * v - q_power - q_power;
+            q_power *= q_power;
+            if (bits[i] == '1')
+            {
+                const modint next_u = (u + v) * half;
+                v = (d * u + v) * half;
+                u = next_u;
+                q_power *= q;
+            }
+        }
+
+        if (u == zero || v == zero)
+            return true;
+        for (std::size_t r = 1; r < s; r++)
+        {
+            v = v * v - q_power - q_power;
+            q_power *= q_power;
+            if (v == zero)
+                return true;
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Baillie-PSW probable prime test: trial division by the primes below 2048, a strong test to base 2 and a strong
+ * Lucas test. No composite number is known to pass it. Numbers below 2048^2 are decided by trial division alone.
+ * @param n The number to be tested
+ * @param rounds Number of extra strong tests, to the odd primes 3, 5, 7, ... as bases
+ * @return True iff <n> is a probable prime. Always false for numbers below 2.
+ */
+inline bool is_probable_prime(const bigint &n, int rounds = 0)
+{
+    if (n < bigint(2))
+        return false;
+    if ((n % bigint(2)) == bigint())
+        return n == bigint(2);
+
+    const std::vector<std::uint32_t> &primes = bigint_sieve::primes();
+    const std::vector<std::uint32_t> remainders = bigint_sieve::residues(n);
+    const bool small = n.fits_uint64() && n.to_uint64() <= bigint_sieve::trial_division_bound();
+    for (std::size_t i = 0; i < primes.size(); i++)
+    {
+        if (remainders[i] == 0)
+            return small && n.to_uint64() == primes[i];
+    }
+    if (small)
+        return true;
+
+    if (!bigint_primality::miller_rabin(n, bigint(2)) || !bigint_primality::strong_lucas(n))
+        return false;
+    for (int i = 0; i < rounds && static_cast<std::size_t>(i) < primes.size(); i++)
+    {
+        if (!bigint_primality::miller_rabin(n, bigint(primes[static_cast<std::size_t>(i)])))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Smallest probable prime greater than a number.
+ * The remainders of the first candidate by the primes below 2048 are taken once and then stepped by 2 with word
+ * arithmetic, so only candidates without a small factor are tested with exponentiation.
+ * @param n The number
+ * @return The next probable prime, 2 for numbers below 2
+ */
+inline bigint next_prime(const bigint &n)
+{
+    if (n < bigint(2))
+        return bigint(2);
+
+    bigint start = n + bigint(1);
+    if ((start % bigint(2)) == bigint())
+        start += bigint(1);
+    if (start.fits_uint64() && start.to_uint64() <= bigint_sieve::trial_division_bound())
+    {
+        while (!is_probable_prime(start))
+            start += bigint(2);
+        return start;
+    }
+
+    const std::vector<std::uint32_t> &primes = bigint_sieve::primes();
+    std::vector<std::uint32_t> remainders = bigint_sieve::residues(start);
+    for (std::int64_t offset = 0;; offset += 2)
+    {
+        if (std::find(remainders.begin(), remainders.end(), 0u) == remainders.end())
+        {
+            bigint candidate = start + bigint(offset);
+            if (bigint_primality::miller_rabin(candidate, bigint(2)) && bigint_primality::strong_lucas(candidate))
+                return candidate;
+        }
+        for (std::size_t i = 0; i < primes.size(); i++)
+        {
+            remainders[i] += 2;
+            if (remainders[i] >= primes[i])
+                remainders[i] -= primes[i];
+        }
+    }
+}
+
+#endif
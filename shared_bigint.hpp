@@ -0,0 +1,449 @@
+#ifndef SHARED_BIGINT_HPP
+#define SHARED_BIGINT_HPP
+
+#include "bigint.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <utility>
+
+/**
+ * @brief Copy-on-write handle to an immutable bigint, for values shared read-only across data structures and threads.
+ * Copies share the digits through a reference count, so copying is O(1). Every operation reads both operands in place
+ * and writes its result into a new buffer, which replaces the digits if no other handle shares them and gets a node of
+ * its own otherwise, so the shared digits are never copied just to be overwritten.
+ * Reading and copying the same handle from several threads is safe, as the digits are never changed while shared and
+ * the reference count is atomic. Dropping a handle releases its writes to the count, and the check before an in-place
+ * write acquires them, so the last owner sees every read of other threads finished before it writes. As for any
+ * standard type, a handle must not be changed while another thread uses it.
+ */
+class shared_bigint
+{
+private:
+    /**
+     * @brief The shared number and its reference count. shared_ptr::use_count is a relaxed load, which does not order
+     * the reads of a handle dropped on another thread before an in-place write, so the count is kept here instead.
+     */
+    struct node
+    {
+        std::atomic<long> references{1};
+        bigint value;
+
+        explicit node(bigint num) : value(std::move(num))
+        {
+        }
+    };
+
+    node *storage; // Never null
+
+    /**
+     * @brief Add a reference to the node of this handle
+     * @return The node
+     */
+    node *retain() const noexcept
+    {
+        // A new reference is made from an existing one, so no ordering is needed (as in shared_ptr)
+        this->storage->references.fetch_add(1, std::memory_order_relaxed);
+        return this->storage;
+    }
+
+    /**
+     * @brief Drop the reference of this handle and free the node if it was the last one
+     */
+    void release() noexcept
+    {
+        if (this->storage->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this->storage;
+    }
+
+    /**
+     * @brief Check if this handle is the only owner of its node
+     * @return True iff no other handle shares the digits, with the reads of dropped handles ordered before the caller
+     */
+    bool unique() const noexcept
+    {
+        return this->storage->references.load(std::memory_order_acquire) == 1;
+    }
+
+    /**
+     * @brief Point this handle to a new node holding a number
+     * @param num The number
+     */
+    void reset(bigint num)
+    {
+        node *replacement = new node(std::move(num));
+        release();
+        this->storage = replacement;
+    }
+
+    /**
+     * @brief Sum of two numbers, reading both in place
+     * @param lhs The first number
+     * @param rhs The second number
+     * @return The sum in a new buffer
+     */
+    static bigint sum(const bigint &lhs, const bigint &rhs)
+    {
+        return bigint::signed_sum(lhs.digits, lhs.isNegative, rhs.digits, rhs.isNegative);
+    }
+
+    /**
+     * @brief Difference of two numbers, reading both in place
+     * @param lhs The number to be subtracted from
+     * @param rhs The number to be subtracted
+     * @return The difference in a new buffer
+     */
+    static bigint difference(const bigint &lhs, const bigint &rhs)
+    {
+        // Flip the sign of the operand instead of copying its negation, zero has no sign to flip
+        return bigint::signed_sum(lhs.digits, lhs.isNegative, rhs.digits,
+                                  !rhs.isNegative && !bigint::is_abs_zero(rhs.digits));
+    }
+
+    /**
+     * @brief Product of two numbers, reading both in place
+     * @param lhs The first number
+     * @param rhs The second number
+     * @return The product in a new buffer
+     */
+    static bigint product(const bigint &lhs, const bigint &rhs)
+    {
+        return bigint::signed_product(lhs.digits, lhs.isNegative, rhs.digits, rhs.isNegative);
+    }
+
+    /**
+     * @brief Quotient of two numbers, reading both in place
+     * @param lhs The dividend
+     * @param rhs The divisor
+     * @return The quotient in a new buffer
+     */
+    static bigint quotient(const bigint &lhs, const bigint &rhs)
+    {
+        return bigint::signed_quotient(lhs.digits, lhs.isNegative, rhs.digits, rhs.isNegative);
+    }
+
+    /**
+     * @brief Remainder of the division of two numbers, reading both in place
+     * @param lhs The dividend
+     * @param rhs The divisor
+     * @return The remainder in a new buffer, with the sign of the dividend
+     */
+    static bigint remainder(const bigint &lhs, const bigint &rhs)
+    {
+        return bigint::signed_remainder(lhs.digits, lhs.isNegative, rhs.digits);
+    }
+
+    /**
+     * @brief Apply a compound operator. The result is computed before anything changes, so <rhs> may be the number of this
+     * handle itself, as in s += s.
+     * @param kernel One of sum, difference, product, quotient and remainder
+     * @param rhs The right-hand side
+     */
+    void apply(bigint (*kernel)(const bigint &, const bigint &), const bigint &rhs)
+    {
+        bigint result = kernel(this->storage->value, rhs);
+        if (unique())
+            this->storage->value = std::move(result);
+        else
+            reset(std::move(result));
+    }
+
+public:
+    /**
+     * @brief Default constructor: Initialize the number to 0
+     */
+    shared_bigint() : storage(new node(bigint()))
+    {
+    }
+
+    /**
+     * @brief Bigint constructor: Take over the digits of a number
+     * @param num Number to be stored
+     */
+    explicit shared_bigint(bigint num) : storage(new node(std::move(num)))
+    {
+    }
+
+    /**
+     * @brief Copy constructor: Share the digits of another handle in O(1)
+     * @param other Handle to be copied
+     */
+    shared_bigint(const shared_bigint &other) noexcept : storage(other.retain())
+    {
+    }
+
+    /**
+     * @brief Copy assignment operator: Share the digits of another handle and drop the current ones
+     * @param other Handle to be copied
+     * @return The current handle after assignment
+     */
+    shared_bigint &operator=(const shared_bigint &other) noexcept
+    {
+        node *shared = other.retain();
+        release();
+        this->storage = shared;
+        return *this;
+    }
+
+    /**
+     * @brief Destructor: Drop the reference and free the digits if this was the last handle
+     */
+    ~shared_bigint()
+    {
+        release();
+    }
+
+    /**
+     * @brief Access the stored number, valid until this handle is changed or destroyed
+     * @return The stored number
+     */
+    const bigint &value() const noexcept
+    {
+        return this->storage->value;
+    }
+
+    /**
+     * @brief Conversion Operator: Use the handle wherever a const bigint reference is expected
+     * @return The stored number
+     */
+    operator const bigint &() const noexcept
+    {
+        return this->storage->value;
+    }
+
+    /**
+     * @brief Number of handles sharing the digits
+     * @return The reference count, 1 if the digits are not shared
+     */
+    long use_count() const noexcept
+    {
+        return this->storage->references.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Writable access to the number. The digits are copied first if another handle shares them.
+     * @return The number, valid until this handle is copied, changed or destroyed
+     */
+    bigint &mutable_value()
+    {
+        if (!unique())
+            reset(this->storage->value);
+        return this->storage->value;
+    }
+
+    /**
+     * @brief Negation Operator: Zero is shared, other numbers are negated into a new buffer
+     * @return A new handle to the negated number
+     */
+    shared_bigint operator-() const
+    {
+        if (this->storage->value == bigint())
+            return *this;
+        return shared_bigint(-this->storage->value);
+    }
+
+    /**
+     * @brief Prefix Increment Operator
+     * @return The current handle after the increment
+     */
+    shared_bigint &operator++()
+    {
+        apply(sum, bigint(1));
+        return *this;
+    }
+
+    /**
+     * @brief Postfix Increment Operator: The old value is returned by sharing it, not by copying its digits
+     * @return A handle to the value before the increment
+     */
+    shared_bigint operator++(int)
+    {
+        shared_bigint old = *this;
+        ++*this;
+        return old;
+    }
+
+    /**
+     * @brief Prefix Decrement Operator
+     * @return The current handle after the decrement
+     */
+    shared_bigint &operator--()
+    {
+        apply(difference, bigint(1));
+        return *this;
+    }
+
+    /**
+     * @brief Postfix Decrement Operator: The old value is returned by sharing it, not by copying its digits
+     * @return A handle to the value before the decrement
+     */
+    shared_bigint operator--(int)
+    {
+        shared_bigint old = *this;
+        --*this;
+        return old;
+    }
+
+    /**
+     * @brief Addition Assignment Operator
+     * @param rhs Number to be added
+     * @return The current handle after addition
+     */
+    shared_bigint &operator+=(const bigint &rhs)
+    {
+        apply(sum, rhs);
+        return *this;
+    }
+
+    /**
+     * @brief Subtraction Assignment Operator
+     * @param rhs Number to be subtracted
+     * @return The current handle after subtraction
+     */
+    shared_bigint &operator-=(const bigint &rhs)
+    {
+        apply(difference, rhs);
+        return *this;
+    }
+
+    /**
+     * @brief Multiplication Assignment Operator
+     * @param rhs Number to be multiplied with
+     * @return The current handle after multiplication
+     */
+    shared_bigint &operator*=(const bigint &rhs)
+    {
+        apply(product, rhs);
+        return *this;
+    }
+
+    /**
+     * @brief Division Assignment Operator
+     * @param rhs Number to divide by
+     * @return The current handle after division
+     */
+    shared_bigint &operator/=(const bigint &rhs)
+    {
+        apply(quotient, rhs);
+        return *this;
+    }
+
+    /**
+     * @brief Modulo Assignment Operator
+     * @param rhs Number to divide by
+     * @return The current handle after the operation, with the sign of the dividend
+     */
+    shared_bigint &operator%=(const bigint &rhs)
+    {
+        apply(remainder, rhs);
+        return *this;
+    }
+
+    /**
+     * @brief Addition Operator: Neither operand is copied, the sum goes into a new buffer
+     * @param lhs The first number
+     * @param rhs The second number
+     * @return A new handle to the sum
+     */
+    friend shared_bigint operator+(const shared_bigint &lhs, const bigint &rhs)
+    {
+        return shared_bigint(sum(lhs.value(), rhs));
+    }
+
+    /**
+     * @brief Subtraction Operator: Neither operand is copied, the difference goes into a new buffer
+     * @param lhs The number to be subtracted from
+     * @param rhs The number to be subtracted
+     * @return A new handle to the difference
+     */
+    friend shared_bigint operator-(const shared_bigint &lhs, const bigint &rhs)
+    {
+        return shared_bigint(difference(lhs.value(), rhs));
+    }
+
+    /**
+     * @brief Multiplication Operator: Neither operand is copied, the product goes into a new buffer
+     * @param lhs The first number
+     * @param rhs The second number
+     * @return A new handle to the product
+     */
+    friend shared_bigint operator*(const shared_bigint &lhs, const bigint &rhs)
+    {
+        return shared_bigint(product(lhs.value(), rhs));
+    }
+
+    /**
+     * @brief Division Operator: Neither operand is copied, the quotient goes into a new buffer
+     * @param lhs The dividend
+     * @param rhs The divisor
+     * @return A new handle to the quotient
+     */
+    friend shared_bigint operator/(const shared_bigint &lhs, const bigint &rhs)
+    {
+        return shared_bigint(quotient(lhs.value(), rhs));
+    }
+
+    /**
+     * @brief Modulo Operator: Neither operand is copied, the remainder goes into a new buffer
+     * @param lhs The dividend
+     * @param rhs The divisor
+     * @return A new handle to the remainder, with the sign of the dividend
+     */
+    friend shared_bigint operator%(const shared_bigint &lhs, const bigint &rhs)
+    {
+        return shared_bigint(remainder(lhs.value(), rhs));
+    }
+
+    /**
+     * @brief Equality Operator: Handles sharing the same digits are equal without comparing them
+     * @param rhs The handle to be compared with
+     * @return True iff the two numbers are equal
+     */
+    bool operator==(const shared_bigint &rhs) const
+    {
+        return this->storage == rhs.storage || this->storage->value == rhs.storage->value;
+    }
+
+    /**
+     * @brief Inequality Operator
+     * @param rhs The handle to be compared with
+     * @return True iff the two numbers are not equal
+     */
+    bool operator!=(const shared_bigint &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @brief Less Than Operator
+     * @param rhs The handle to be compared with
+     * @return True iff the current number is less than <rhs>
+     */
+    bool operator<(const shared_bigint &rhs) const
+    {
+        return this->storage->value < rhs.storage->value;
+    }
+
+    /**
+     * @brief Insertion Operator: Send the number to the output stream
+     * @param stream Output stream to send the number
+     * @param num Handle of the number to be sent
+     * @return The output stream after sending the number
+     */
+    friend std::ostream &operator<<(std::ostream &stream, const shared_bigint &num)
+    {
+        return stream << num.value();
+    }
+};
+
+template <>
+struct std::hash<shared_bigint>
+{
+    std::size_t operator()(const shared_bigint &num) const noexcept
+    {
+        return num.value().hash();
+    }
+};
+
+#endif
@@ -1,7 +1,21 @@
+// Turn on the probes, so the tests can count the allocations of the scratch pool
+#define BIGINT_ENABLE_INSTRUMENTATION
 #include "bigint.hpp"
+#include "bigint_async.hpp"
+#include "bigdecimal.hpp"
+#include "bigint_mmap.hpp"
+#include "bigrational.hpp"
+#include "fixed_bigint.hpp"
+#include "modint.hpp"
+#include "shared_bigint.hpp"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <string>
 #include <sstream>
 #include <random>
+#include <thread>
+#include <unordered_map>
 
 class Test
 {
@@ -741,290 +755,2081 @@ public:
         return num1 == expected;
     }
 
+    /**
+     * @brief Test if products around and far above the Karatsuba threshold, balanced and unbalanced, match the fused
+     * multiply-add, which always works digit row by digit row
+     * @return True iff every product matches
+     */
+    static bool test_karatsuba_matches_rows()
+    {
+        std::mt19937_64 rng(19);
+        const auto random_number = [&rng](std::size_t size)
+        {
+            const bigint value = bigint::random_digits(size, rng);
+            return rng() % 2 ? -value : value;
+        };
+
+        for (int i = 0; i < 60; i++)
+        {
+            const bigint a = random_number(1 + rng() % 600);
+            const bigint b = random_number(1 + rng() % 600);
+            bigint expected;
+            addmul(expected, a, b);
+            if (a * b != expected)
+                return false;
+        }
+
+        // Zeros in the middle make the low halves carry leading zeros
+        const bigint sparse("1" + std::string(150, '0') + "1" + std::string(150, '0') + "1");
+        bigint expected;
+        addmul(expected, sparse, sparse);
+        return sparse * sparse == expected;
+    }
+
     /**
      * @brief Test if the division assignment operator correctly divides two positive numbers
      * @return True iff the result is correct
      */
     static bool test_division_assignment_all_positive()
     {
-        bigint num1(74);
-        const bigint num2(07);
-        num1 /= num2;
-        const auto expected = bigint(74 / 07);
-        return num1 == expected;
+        bigint num1(74);
+        const bigint num2(07);
+        num1 /= num2;
+        const auto expected = bigint(74 / 07);
+        return num1 == expected;
+    }
+
+    /**
+     * @brief Test if the division assignment operator correctly divides two negative numbers
+     * @return True iff the result is correct
+     */
+    static bool test_division_assignment_all_negative()
+    {
+        bigint num1(-456);
+        const bigint num2(-123);
+        num1 /= num2;
+        const auto expected = bigint(-456 / -123);
+        return num1 == expected;
+    }
+
+    /**
+     * @brief Test if the division assignment operator correctly divides a positive and a negative number
+     * @return True iff the result is correct
+     */
+    static bool test_division_assignment_positive_negative()
+    {
+        bigint num1(456);
+        const bigint num2(-123);
+        num1 /= num2;
+        const auto expected = bigint(456 / -123);
+        return num1 == expected;
+    }
+
+    /**
+     * @brief Test if the division assignment operator correctly divides a negative and a positive number
+     * @return True iff the result is correct
+     */
+    static bool test_division_assignment_negative_positive()
+    {
+        bigint num1(-456);
+        const bigint num2(123);
+        num1 /= num2;
+        const auto expected = bigint(-456 / 123);
+        return num1 == expected;
+    }
+
+    /**
+     * @brief Test if the division assignment operator correctly divides zero and a number
+     * @return True iff the result is zero
+     */
+    static bool test_division_assignment_zero()
+    {
+        bigint num1(0);
+        const bigint num2(-123);
+        num1 /= num2;
+        const auto expected = bigint(0);
+        return num1 == expected;
+    }
+
+    /**
+     * @brief Test if the division assignment operator correctly divides by 1
+     * @return True iff the result is correct
+     */
+    static bool test_division_assignment_one()
+    {
+        bigint num1(123);
+        const bigint num2(1);
+        num1 /= num2;
+        const auto expected = bigint(123 / 1);
+        return num1 == expected;
+    }
+
+    /**
+     * @brief Test if the division assignment operator correctly divides two same number
+     * @return
+     */
+    static bool test_division_assignment_same()
+    {
+        bigint num1(123);
+        const bigint num2(123);
+        num1 /= num2;
+        const auto expected = bigint(1);
+        return num1 == expected;
+    }
+
+    /**
+     * @brief Test if the division assignment operator triggers an exception when dividing by zero
+     * @return True iff the exception is thrown
+     */
+    static bool test_division_assignment_division_by_zero()
+    {
+        bigint num1(123);
+        const bigint num2(0);
+        try
+        {
+            num1 /= num2;
+            return false;
+        }
+        catch (const std::logic_error &)
+        {
+            return true;
+        }
+    }
+
+    /**
+     * @brief Test if the addition operator correctly returns the sum of two positive numbers without modifying the original numbers
+     * @return True iff the original numbers are not modified and the returned number is correct
+     */
+    static bool test_addition_operator_properties()
+    {
+        const bigint num1(123);
+        const bigint num2(456);
+        const auto result = num1 + num2;
+        const auto expected = bigint(123 + 456);
+        return result == expected && num1 == bigint(123) && num2 == bigint(456);
+    }
+
+    /**
+     * @brief Test if the subtraction operator correctly returns the difference of two numbers without modifying the original numbers
+     * @return True iff the original numbers are not modified and the returned number is correct
+     */
+    static bool test_subtraction_operator_properties()
+    {
+        const bigint num1(456);
+        const bigint num2(123);
+        const auto result = num1 - num2;
+        const auto expected = bigint(456 - 123);
+        return result == expected && num1 == bigint(456) && num2 == bigint(123);
+    }
+
+    /**
+     * @brief Test if the multiplication operator correctly returns the product of two numbers without modifying the original numbers
+     * @return True iff the original numbers are not modified and the returned number is correct
+     */
+    static bool test_multiplication_operator_properties()
+    {
+        const bigint num1(123);
+        const bigint num2(456);
+        const auto result = num1 * num2;
+        const auto expected = bigint(123 * 456);
+        return result == expected && num1 == bigint(123) && num2 == bigint(456);
+    }
+
+    /**
+     * @brief Test if the division operator correctly returns the quotient of two numbers without modifying the original numbers
+     * @return True iff the original numbers are not modified and the returned number is correct
+     */
+    static bool test_division_operator_properties()
+    {
+        const bigint num1(456);
+        const bigint num2(123);
+        const auto result = num1 / num2;
+        const auto expected = bigint(456 / 123);
+        return result == expected && num1 == bigint(456) && num2 == bigint(123);
+    }
+
+    /**
+     * @brief Test if the inequality operator correctly compares two different numbers
+     * @return True iff the two numbers are not equal
+     */
+    static bool test_inequality_operator()
+    {
+        const bigint num1(123);
+        const bigint num2(456);
+        return num1 != num2;
+    }
+
+    /**
+     * @brief Test if the less than operator correctly compares two positive numbers
+     * @return True iff the first number is less than the second number
+     */
+    static bool test_less_than_operator_all_positive()
+    {
+        const bigint num1(123);
+        const bigint num2(456);
+        return num1 < num2;
+    }
+
+    /**
+     * @brief Test if the less than operator correctly compares two negative numbers
+     * @return True iff the first number is less than the second number
+     */
+    static bool test_less_than_operator_all_negative()
+    {
+        const bigint num1(-456);
+        const bigint num2(-123);
+        return num1 < num2;
+    }
+
+    /**
+     * @brief Test if the less than operator correctly compares a positive and a negative number
+     * @return True if the first number if negative
+     */
+    static bool test_less_than_operator_mixed()
+    {
+        const bigint num1(-123);
+        const bigint num2(123);
+        return num1 < num2;
+    }
+
+    /**
+     * @brief Test if the less than or equal operator correctly compares two same numbers
+     * @return True iff the two numbers are equal
+     */
+    static bool test_less_than_equal_operator_equal()
+    {
+        const bigint num1(123);
+        const bigint num2(123);
+        return num1 <= num2;
+    }
+
+    /**
+     * @brief Test if the less than or equal operator correctly compares negative number and zero
+     * @return True iff the first number is negative
+     */
+    static bool test_less_than_equal_operator_less_than()
+    {
+        const bigint num1(-456);
+        const bigint num2(0);
+        return num1 <= num2;
+    }
+
+    /**
+     * @brief Test greater than operator correctly compares two number
+     * @return True iff the first number is greater than the second number
+     */
+    static bool test_greater_than_operator()
+    {
+        const bigint num1(123);
+        const bigint num2(0);
+        return num1 > num2;
+    }
+
+    /**
+     * @brief Test greater than or equal operator correctly compares two equal numbers
+     * @return True iff the two numbers are equal
+     */
+    static bool test_greater_than_equal_operator()
+    {
+        const bigint num1(123);
+        const bigint num2(123);
+        return num1 >= num2;
+    }
+
+    /**
+     * @brief Test if the insertion operator correctly sends the positive number to the output stream
+     * @return True if the two strings are equal
+     */
+    static bool test_insertion_operator_positive()
+    {
+        const bigint num(123);
+        std::ostringstream stream;
+        stream << num;
+        return stream.str() == "123";
+    }
+
+    /**
+     * @brief Test if the insertion operator correctly sends the negative number to the output stream
+     * @return True if the two strings are equal
+     */
+    static bool test_insertion_operator_negative()
+    {
+        const bigint num(-123);
+        std::ostringstream stream;
+        stream << num;
+        return stream.str() == "-123";
+    }
+
+    /**
+     * @brief Test if the insertion operator correctly sends zero to the output stream
+     * @return True if the two strings are equal
+     */
+    static bool test_insertion_operator_zero()
+    {
+        const bigint num(0);
+        std::ostringstream stream;
+        stream << num;
+        return stream.str() == "0";
+    }
+
+    /**
+     * @brief Test if constructors, arithmetic and comparisons can be evaluated at compile time
+     * @return True iff the compile-time results are correct
+     */
+    static bool test_constexpr_arithmetic()
+    {
+        constexpr bool result = bigint("123456789012345678901234567890") * bigint(-2) ==
+                                    bigint("-246913578024691357802469135780") &&
+                                bigint(std::numeric_limits<std::int64_t>::min()) < bigint(0) &&
+                                (bigint(1000) - bigint(1)) / bigint(9) == bigint(111) && ++bigint(-1) == bigint();
+        return result;
+    }
+
+    /**
+     * @brief Test if the literal operator parses at compile time and materializes the same number at runtime
+     * @return True iff the literals equal the numbers built from strings
+     */
+    static bool test_constexpr_literal()
+    {
+        constexpr bool compile_time = 1'000'000'000'000'000'000'000_big == bigint("1000000000000000000000") &&
+                                      -007_big == bigint(-7);
+        const bigint runtime = 98765432109876543210987654321_big;
+        return compile_time && runtime == bigint("98765432109876543210987654321");
+    }
+
+    /**
+     * @brief Test if fixed-width arithmetic matches bigint arithmetic on values that fit
+     * @return True iff every result matches
+     */
+    static bool test_fixed_arithmetic()
+    {
+        const bigint a("-340282366920938463463374607431768211457005");
+        const bigint b("340282366920938463463374607431768211457");
+        const int256 x(a);
+        const int256 y(b);
+        const int256 z(-12345);
+        return (x + y).to_bigint() == a + b && (x - y).to_bigint() == a - b && (y * z).to_bigint() == b * bigint(-12345) &&
+               (x / y).to_bigint() == bigint(-1000) && (x % y).to_bigint() == bigint(-5) && x < y && z > x &&
+               x.to_bigint() == a;
+    }
+
+    /**
+     * @brief Test limb division against bigint division on operands built from edge-case limbs, so that short division,
+     * normalization shifts of 0 and the rare add-back step are all reached
+     * @return True iff every quotient and remainder matches
+     */
+    static bool test_fixed_division()
+    {
+        std::mt19937_64 rng(32);
+        const std::uint64_t patterns[] = {0, 1, 3, ~std::uint64_t{0}, std::uint64_t{1} << 63, (std::uint64_t{1} << 63) - 1};
+        const auto random_operand = [&]
+        {
+            // Up to 4 limbs below 2^255, so the value stays positive in 256 bits
+            std::vector<std::byte> bytes;
+            const std::size_t limbs = 1 + rng() % 4;
+            for (std::size_t i = 0; i < limbs; i++)
+            {
+                std::uint64_t limb = rng() % 3 == 0 ? rng() : patterns[rng() % std::size(patterns)];
+                if (i == 0 && limbs == 4)
+                    limb >>= 1;
+                for (int b = 7; b >= 0; b--)
+                    bytes.push_back(static_cast<std::byte>(limb >> (8 * b)));
+            }
+            const bigint num = bigint::from_bytes(bytes);
+            return rng() % 2 == 0 ? num : -num;
+        };
+
+        for (int i = 0; i < 20000; i++)
+        {
+            const bigint a = random_operand();
+            const bigint b = random_operand();
+            if (b == bigint())
+                continue;
+            const int256 x(a);
+            const int256 y(b);
+            if ((x / y).to_bigint() != a / b || (x % y).to_bigint() != a % b)
+                return false;
+        }
+
+        // Knuth's add-back case: the estimate from the top limbs is one too large
+        const bigint u("40000000000000000000000000000000000000000000000010a135742ec634a3", 16);
+        const bigint v("100000000000000000000000000000001", 16);
+        return (int256(u) / int256(v)).to_bigint() == u / v && (int256(u) % int256(v)).to_bigint() == u % v;
+    }
+
+    /**
+     * @brief Test if the wrapping mode keeps the low bits like the built-in unsigned integers
+     * @return True iff the results wrap around
+     */
+    static bool test_fixed_wrap()
+    {
+        const auto max = fixed_bigint<128>(bigint("170141183460469231731687303715884105727"));
+        const auto min = max + fixed_bigint<128>(1);
+        return min.to_bigint() == bigint("-170141183460469231731687303715884105728") && -min == min &&
+               fixed_bigint<128>(bigint("340282366920938463463374607431768211457")) == fixed_bigint<128>(1) &&
+               (max * max).to_bigint() == bigint(1);
+    }
+
+    /**
+     * @brief Test if the checked mode throws on overflow and not on the edge values
+     * @return True iff only the overflowing operations throw
+     */
+    static bool test_fixed_checked()
+    {
+        using checked = fixed_bigint<128, overflow_mode::checked>;
+        const checked min(bigint("-170141183460469231731687303715884105728"));
+        const checked max(bigint("170141183460469231731687303715884105727"));
+        int thrown = 0;
+        for (const auto &operation : {
+                 +[](const checked &lo, const checked &) { return lo - checked(1); },
+                 +[](const checked &, const checked &hi) { return hi + checked(1); },
+                 +[](const checked &lo, const checked &) { return -lo; },
+                 +[](const checked &lo, const checked &) { return lo / checked(-1); },
+                 +[](const checked &, const checked &hi) { return hi * checked(2); },
+             })
+        {
+            try
+            {
+                operation(min, max);
+            }
+            catch (const std::overflow_error &)
+            {
+                thrown++;
+            }
+        }
+
+        try
+        {
+            checked(bigint("170141183460469231731687303715884105728"));
+        }
+        catch (const std::overflow_error &)
+        {
+            thrown++;
+        }
+        return thrown == 6 && (min + max) == checked(-1) && (max * checked(-1) - checked(1)) == min;
+    }
+
+    /**
+     * @brief Test if fused multiply-add and multiply-subtract match the result of the separate operators
+     * @return True iff every result matches
+     */
+    static bool test_addmul_submul()
+    {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<std::int64_t> dist(std::numeric_limits<std::int64_t>::min(),
+                                                         std::numeric_limits<std::int64_t>::max());
+        for (int i = 0; i < 2000; i++)
+        {
+            const bigint acc = bigint(dist(rng)) * bigint(dist(rng) % 1000);
+            const bigint b = bigint(dist(rng)) * bigint(dist(rng));
+            const std::int64_t word = i % 2 == 0 ? dist(rng) : dist(rng) % 100;
+            const bigint c(dist(rng));
+
+            bigint fused_add = acc;
+            bigint fused_sub = acc;
+            bigint fused_add_word = acc;
+            bigint fused_sub_word = acc;
+            addmul(fused_add, b, c);
+            submul(fused_sub, b, c);
+            addmul(fused_add_word, b, word);
+            submul(fused_sub_word, b, word);
+            if (fused_add != acc + b * c || fused_sub != acc - b * c || fused_add_word != acc + b * bigint(word) ||
+                fused_sub_word != acc - b * bigint(word))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Test if fused operations cancel to zero and handle the minimum of int64_t as the word
+     * @return True iff the results are correct
+     */
+    static bool test_addmul_edge_cases()
+    {
+        bigint acc("-1000000000000000000000");
+        addmul(acc, bigint("10000000000000000000"), 100);
+        bigint min_word(0);
+        addmul(min_word, bigint(-1), std::numeric_limits<std::int64_t>::min());
+        bigint self(12);
+        submul(self, self, self);
+        return acc == bigint() && min_word == bigint("9223372036854775808") && self == bigint(-132);
+    }
+
+    /**
+     * @brief Test if factorials below and above the prime factorization threshold match repeated multiplication
+     * @return True iff the factorials are equal
+     */
+    static bool test_factorial()
+    {
+        bigint expected(1);
+        for (std::int64_t n = 0; n <= 300; n++)
+        {
+            if (n > 0)
+                expected *= bigint(n);
+            if (bigint::factorial(n) != expected)
+                return false;
+        }
+        return bigint::factorial(25) == bigint("15511210043330985984000000");
+    }
+
+    /**
+     * @brief Test if binomial coefficients match Pascal's triangle, are zero outside of it and are quick for a huge n with a
+     * small k
+     * @return True iff the coefficients are correct
+     */
+    static bool test_binomial()
+    {
+        std::vector<bigint> row{bigint(1)};
+        for (std::int64_t n = 1; n <= 120; n++)
+        {
+            std::vector<bigint> next(row.size() + 1, bigint(1));
+            for (std::size_t k = 1; k < row.size(); k++)
+                next[k] = row[k - 1] + row[k];
+            row = std::move(next);
+            for (std::int64_t k = 0; k <= n; k++)
+            {
+                if (bigint::binomial(n, k) != row[k])
+                    return false;
+            }
+        }
+        const std::int64_t huge = 1000000000000000000;
+        const bigint falling = bigint(huge) * bigint(huge - 1) * bigint(huge - 2) * bigint(huge - 3);
+        return bigint::binomial(100, 50) == bigint("100891344545564193334812497256") &&
+               bigint::binomial(5, -1) == bigint() && bigint::binomial(5, 6) == bigint() &&
+               bigint::binomial(200000000, 2) == bigint(19999999900000000) &&
+               bigint::binomial(huge, 4) == falling / bigint(24) && bigint::binomial(huge, huge - 4) == falling / bigint(24);
+    }
+
+    /**
+     * @brief Test if primorials and products of ranges are correct, including empty ranges and negative factors
+     * @return True iff the products are correct
+     */
+    static bool test_primorial_and_product()
+    {
+        const std::vector<int> words{1, -2, 3, 4};
+        const std::vector<bigint> numbers{bigint("123456789012345678901234567890"), bigint(-3), bigint(7)};
+        return bigint::primorial(30) == bigint(6469693230) && bigint::primorial(1) == bigint(1) &&
+               bigint::product(words) == bigint(-24) && bigint::product(std::vector<bigint>()) == bigint(1) &&
+               bigint::product(numbers) == bigint("-2592592569259259256925925925690");
+    }
+
+    /**
+     * @brief Test if asynchronous operations give the same results as the operators and report increasing progress
+     * @return True iff the results match and the progress ends at 1
+     */
+    static bool test_async_results_and_progress()
+    {
+        const bigint a = bigint::factorial(400);
+        const bigint b = bigint::primorial(300) + bigint(7);
+
+        std::vector<double> fractions;
+        bigint_async_options options;
+        options.progress = [&fractions](double fraction) { fractions.push_back(fraction); };
+        const bigint product = multiply_async(a, b, options).get();
+
+        const bool increasing = std::is_sorted(fractions.begin(), fractions.end());
+        return product == a * b && !fractions.empty() && increasing && fractions.back() == 1.0 &&
+               divide_async(a, b).get() == a / b && modulo_async(-a, b).get() == -a % b &&
+               to_string_async(a, 16).get() == a.to_string(16) && parse_async(a.to_string(36), 36).get() == a;
+    }
+
+    /**
+     * @brief Test if a stop request, a stop from the progress callback and a past deadline cancel an operation
+     * @return True iff all three futures throw bigint_cancelled
+     */
+    static bool test_async_cancellation()
+    {
+        const bigint a = bigint::factorial(1500);
+        const auto cancelled = [](std::future<bigint> future)
+        {
+            try
+            {
+                future.get();
+            }
+            catch (const bigint_cancelled &)
+            {
+                return true;
+            }
+            return false;
+        };
+
+        std::stop_source before;
+        before.request_stop();
+        bigint_async_options stopped;
+        stopped.stop = before.get_token();
+
+        std::stop_source during;
+        bigint_async_options from_callback;
+        from_callback.stop = during.get_token();
+        from_callback.progress = [&during](double) { during.request_stop(); };
+
+        bigint_async_options late;
+        late.deadline = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+
+        return cancelled(multiply_async(a, a, stopped)) && cancelled(divide_async(a * a, a + bigint(1), from_callback)) &&
+               cancelled(parse_async(a.to_string(7), 7, late)) && a * bigint(2) == a + a;
+    }
+
+    /**
+     * @brief Test if the instrumentation counts calls only when it is enabled, and if the JSON dump lists every kernel
+     * @return True iff the snapshot and the dump are correct
+     */
+    static bool test_instrumentation_snapshot()
+    {
+        bigint_instrumentation::reset();
+        const bigint product = bigint::factorial(100) * bigint(3);
+        const bigint_stats snapshot = bigint_instrumentation::snapshot();
+
+        bigint_stats stats;
+        stats.allocations = 2;
+        stats.kernels[static_cast<std::size_t>(bigint_kernel::multiply_schoolbook)].calls = 3;
+        stats.kernels[static_cast<std::size_t>(bigint_kernel::multiply_schoolbook)].size_histogram[2] = 3;
+        const std::string json = stats.to_json();
+
+        const bool counted = snapshot.kernels[static_cast<std::size_t>(bigint_kernel::multiply_schoolbook)].calls > 0;
+        return product != bigint() && counted == bigint_instrumentation::enabled &&
+               (bigint_instrumentation::enabled || snapshot.allocations + snapshot.pool_hits == 0) &&
+               json.rfind("{\"allocations\":2,\"bytes_allocated\":0,\"pool_hits\":0,\"kernels\":{\"add\":", 0) == 0 &&
+               json.find("\"multiply_schoolbook\":{\"calls\":3,\"ticks\":0,\"size_histogram\":[0,0,3]}") != std::string::npos &&
+               json.find("\"format\":{\"calls\":0,\"ticks\":0,\"size_histogram\":[]}}}") != std::string::npos;
+    }
+
+    /**
+     * @brief Test that a loop of compound operators stops allocating after warm-up, and that huge buffers are not kept
+     * @return True iff the steady-state loop allocates nothing and every huge copy allocates
+     */
+    static bool test_scratch_pool_reuse()
+    {
+        const bigint a = bigint::factorial(80);
+        const bigint b = bigint::factorial(60);
+        const auto run = [&]
+        {
+            bigint total = a;
+            total += b;
+            total *= b;
+            total -= a;
+            return total;
+        };
+        for (int i = 0; i < 3; i++)
+            run();
+
+        bigint_instrumentation::reset();
+        for (int i = 0; i < 100; i++)
+            run();
+        const bigint_stats steady = bigint_instrumentation::snapshot();
+
+        // A buffer above the largest class is freed on release, so every copy allocates again
+        const bigint huge(std::string(std::size_t(1) << 21, '7'));
+        bigint_instrumentation::reset();
+        for (int i = 0; i < 2; i++)
+            bigint copy = huge;
+        const bigint_stats unpooled = bigint_instrumentation::snapshot();
+
+        return steady.allocations == 0 && steady.pool_hits > 0 && unpooled.allocations == 2 && unpooled.pool_hits == 0;
+    }
+
+    /**
+     * @brief Test if conversions to int64_t and uint64_t check the range at both ends and truncate like a cast
+     * @return True iff every conversion is correct
+     */
+    static bool test_native_integer_conversions()
+    {
+        const bigint int64_min("-9223372036854775808");
+        const bigint int64_over("9223372036854775808");
+        const bigint uint64_over("18446744073709551616");
+        bool checked = false;
+        try
+        {
+            int64_over.to_int64();
+        }
+        catch (const std::overflow_error &)
+        {
+            checked = true;
+        }
+
+        std::mt19937_64 rng(13);
+        for (int i = 0; i < 10000; i++)
+        {
+            const std::int64_t value = static_cast<std::int64_t>(rng()) >> (rng() % 64);
+            const bigint num(value);
+            if (num.to_int64() != value || !num.fits_int64() || num.fits_uint64() != (value >= 0) ||
+                num.to_uint64(bigint::conversion_mode::truncate) != static_cast<std::uint64_t>(value))
+                return false;
+        }
+
+        return checked && int64_min.fits_int64() && int64_min.to_int64() == std::numeric_limits<std::int64_t>::min() &&
+               !int64_over.fits_int64() && int64_over.fits_uint64() && !uint64_over.fits_uint64() &&
+               uint64_over.to_uint64(bigint::conversion_mode::truncate) == 0 &&
+               (uint64_over + bigint(5)).to_int64(bigint::conversion_mode::truncate) == 5 &&
+               bigint(-1).to_uint64(bigint::conversion_mode::truncate) == std::numeric_limits<std::uint64_t>::max();
+    }
+
+    /**
+     * @brief Test if to_double rounds to nearest with ties to even and overflows to infinity
+     * @return True iff every conversion is correct
+     */
+    static bool test_to_double()
+    {
+        const double inf = std::numeric_limits<double>::infinity();
+        return bigint("9007199254740993").to_double() == 9007199254740992.0 &&
+               bigint("9007199254740995").to_double() == 9007199254740996.0 &&
+               bigint("-18446744073709551617").to_double() == -18446744073709551616.0 &&
+               bigint("100000000000000000000000").to_double() == 1e23 && bigint().to_double() == 0.0 &&
+               bigint(std::string(308, '9')).to_double() == 1e308 && bigint(std::string(309, '9')).to_double() == inf &&
+               (-bigint(std::string(400, '9'))).to_double() == -inf;
+    }
+
+    /**
+     * @brief Test if frexp, log2 and size_in_base match the exact values for words and for numbers beyond double
+     * @return True iff the estimates are correct
+     */
+    static bool test_size_estimates()
+    {
+        std::mt19937_64 rng(17);
+        for (int i = 0; i < 2000; i++)
+        {
+            const std::int64_t value = static_cast<std::int64_t>(rng()) >> (rng() % 64);
+            const bigint num(value);
+            std::int64_t exponent = 0;
+            int expected_exponent = 0;
+            if (num.frexp(exponent) != std::frexp(static_cast<double>(value), &expected_exponent) ||
+                exponent != expected_exponent)
+                return false;
+            for (int base = 2; base <= 36; base++)
+            {
+                if (num.size_in_base(base) != num.to_string(base).size() - (value < 0 ? 1 : 0))
+                    return false;
+            }
+        }
+
+        // 1000! is about 0.6588 * 2^8530
+        const bigint large = bigint::factorial(1000);
+        std::int64_t exponent = 0;
+        const double mantissa = large.frexp(exponent);
+        for (int base = 2; base <= 36; base++)
+        {
+            const std::size_t size = large.size_in_base(base);
+            const std::size_t exact = large.to_string(base).size();
+            if (size != exact && size != exact + 1)
+                return false;
+        }
+        return exponent == 8530 && std::abs(mantissa - 0.658841896076731) < 1e-12 &&
+               std::abs(large.log2() - 8529.398004204773) < 1e-9 && bigint().log2() == -std::numeric_limits<double>::infinity();
+    }
+
+    /**
+     * @brief Test if conversions to and from every base match the digits of a machine word, and round-trip a large number
+     * @return True iff all conversions are correct
+     */
+    static bool test_radix_round_trip()
+    {
+        const std::string symbols = "0123456789abcdefghijklmnopqrstuvwxyz";
+        std::mt19937_64 rng(11);
+        for (int i = 0; i < 5000; i++)
+        {
+            const std::uint64_t value = rng() >> (rng() % 64);
+            const int base = 2 + static_cast<int>(rng() % 35);
+            std::string expected;
+            std::uint64_t rest = value;
+            do
+            {
+                expected.insert(expected.begin(), symbols[rest % base]);
+                rest /= base;
+            } while (rest != 0);
+
+            const bigint num(std::to_string(value));
+            if (num.to_string(base) != expected || bigint(expected, base) != num)
+                return false;
+        }
+
+        const bigint large = -bigint::factorial(500) - bigint(1);
+        for (int base = 2; base <= 36; base++)
+        {
+            if (bigint(large.to_string(base), base) != large)
+                return false;
+        }
+        return bigint("-FF", 16) == bigint(-255) && bigint("+zZ", 36) == bigint(1295) && bigint("-000", 2) == bigint() &&
+               large.to_string() == large.to_string(10);
+    }
+
+    /**
+     * @brief Test if radix conversions reject bases out of range, chars that are not digits in the base and lone signs
+     * @return True iff every case throws invalid_argument
+     */
+    static bool test_radix_errors()
+    {
+        const auto throws = [](auto action)
+        {
+            try
+            {
+                action();
+            }
+            catch (const std::invalid_argument &)
+            {
+                return true;
+            }
+            return false;
+        };
+        return throws([] { bigint(5).to_string(1); }) && throws([] { bigint(5).to_string(37); }) &&
+               throws([] { bigint("12", 37); }) && throws([] { bigint("1g", 16); }) && throws([] { bigint("102", 2); }) &&
+               throws([] { bigint("-", 16); }) && throws([] { bigint("", 16); });
+    }
+
+    /**
+     * @brief Test the string view constructor on substrings and on a bad char at every position around the 8-char blocks
+     * @return True iff every substring is parsed without copying it and every bad char is rejected
+     */
+    static bool test_string_view_parsing()
+    {
+        const std::string buffer = "x-000123456789012345678901234567890y";
+        if (bigint(std::string_view(buffer).substr(1, 34)) != bigint("-123456789012345678901234567890") ||
+            bigint(std::string_view(buffer).substr(2, 3)) != bigint() || bigint(std::string_view("-0000000000")) != bigint())
+            return false;
+
+        for (std::size_t bad = 0; bad < 20; bad++)
+        {
+            for (char c : {'/', ':', ' ', '\xff'})
+            {
+                std::string text(20, '7');
+                text[bad] = c;
+                try
+                {
+                    bigint num(text);
+                    return false;
+                }
+                catch (const std::invalid_argument &)
+                {
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Test from_chars on digit runs, signs, empty input and other bases
+     * @return True iff every result, end pointer and error code matches std::from_chars
+     */
+    static bool test_from_chars()
+    {
+        const std::string_view text = "-98765432109876543210987654321,rest";
+        bigint num(5);
+        const auto [end, error] = from_chars(text.data(), text.data() + text.size(), num);
+        if (error != std::errc() || end != text.data() + 30 || num != bigint("-98765432109876543210987654321"))
+            return false;
+
+        // The buffer of <num> is reused for a shorter number
+        const std::string_view small = "00042";
+        if (from_chars(small.data(), small.data() + small.size(), num).ptr != small.data() + 5 || num != bigint(42))
+            return false;
+
+        // Nothing is parsed from an empty range, a lone sign, a plus sign or a non-digit, and the number is unchanged
+        for (std::string_view bad : {"", "-", "+1", "-x1", " 1"})
+        {
+            const auto result = from_chars(bad.data(), bad.data() + bad.size(), num);
+            if (result.ec != std::errc::invalid_argument || result.ptr != bad.data() || num != bigint(42))
+                return false;
+        }
+
+        const std::string_view hex = "-fFz";
+        const auto result = from_chars(hex.data(), hex.data() + hex.size(), num, 16);
+        const std::string_view zero = "-0";
+        return result.ec == std::errc() && result.ptr == hex.data() + 3 && num == bigint(-255) &&
+               from_chars(zero.data(), zero.data() + zero.size(), num).ec == std::errc() && num == bigint() &&
+               num.to_string() == "0";
+    }
+
+    /**
+     * @brief Test formatted_size on both sides of every power of the base around and beyond 2^64
+     * @return True iff every size matches the length of to_string
+     */
+    static bool test_formatted_size()
+    {
+        for (int base : {2, 3, 10, 16, 36})
+        {
+            bigint power(1);
+            for (int exponent = 0; exponent < 90; exponent++)
+            {
+                for (const bigint &num : {power - bigint(1), power, -power, -(power + bigint(1))})
+                {
+                    if (num.formatted_size(base) != num.to_string(base).size())
+                        return false;
+                }
+                power *= bigint(base);
+            }
+        }
+        return bigint().formatted_size(7) == 1;
+    }
+
+    /**
+     * @brief Test to_chars into exact, short and oversized buffers, and the round trip through from_chars
+     * @return True iff every result, end pointer and error code matches std::to_chars
+     */
+    static bool test_to_chars()
+    {
+        std::array<char, 1024> buffer{};
+        const bigint num = -bigint::factorial(120);
+        for (int base : {10, 16, 2, 36})
+        {
+            const std::string expected = num.to_string(base);
+            const auto [end, error] = to_chars(buffer.data(), buffer.data() + buffer.size(), num, base);
+            if (error != std::errc() || std::string_view(buffer.data(), end) != expected)
+                return false;
+
+            bigint parsed;
+            if (from_chars(buffer.data(), end, parsed, base).ptr != end || parsed != num)
+                return false;
+
+            const auto exact = to_chars(buffer.data(), buffer.data() + expected.size(), num, base);
+            const auto short_by_one = to_chars(buffer.data(), buffer.data() + expected.size() - 1, num, base);
+            if (exact.ec != std::errc() || short_by_one.ec != std::errc::value_too_large ||
+                short_by_one.ptr != buffer.data() + expected.size() - 1)
+                return false;
+        }
+
+        std::ostringstream stream;
+        const bigint large = bigint::factorial(3000);
+        stream << large << ' ' << -large;
+        return stream.str() == large.to_string() + " -" + large.to_string();
+    }
+
+#ifdef __cpp_lib_format
+    /**
+     * @brief Test std::format with fill, alignment, sign, base prefix, zero padding and width
+     * @return True iff every formatted string matches the one of a built-in integer
+     */
+    static bool test_formatter()
+    {
+        const bigint a(-255);
+        const bigint b(255);
+        return std::format("{}", a) == "-255" && std::format("{:x}", a) == "-ff" && std::format("{:#X}", a) == "-0XFF" &&
+               std::format("{:+10}", b) == "      +255" && std::format("{:*^9}", b) == "***255***" &&
+               std::format("{:<6}", a) == "-255  " && std::format("{:#010b}", b) == "0b11111111" &&
+               std::format("{:08}", a) == "-0000255" && std::format("{: o}", b) == " 377" &&
+               std::format("{:#o}", bigint()) == "0";
+    }
+#endif
+
+    /**
+     * @brief Test if division and modulo truncate like int64_t, for all combinations of signs
+     * @return True iff every quotient and remainder matches
+     */
+    static bool test_division_and_modulo_signs()
+    {
+        std::mt19937_64 rng(7);
+        for (int i = 0; i < 20000; i++)
+        {
+            const std::int64_t a = static_cast<std::int64_t>(rng()) >> (rng() % 63);
+            const std::int64_t b = static_cast<std::int64_t>(rng()) >> (rng() % 63);
+            if (b == 0)
+                continue;
+            if (bigint(a) / bigint(b) != bigint(a / b) || bigint(a) % bigint(b) != bigint(a % b))
+                return false;
+        }
+        bigint c(-456);
+        c %= bigint(123);
+        return c == bigint(-87) && bigint(456) % bigint(-123) == bigint(87) && bigint(-246) % bigint(123) == bigint();
+    }
+
+    /**
+     * @brief Test if long division of large numbers satisfies a == (a / b) * b + a % b with |a % b| < |b|
+     * @return True iff the identity holds
+     */
+    static bool test_long_division_identity()
+    {
+        const bigint a = -bigint::factorial(400) + bigint(987654321);
+        const bigint b = bigint::primorial(300) + bigint(1);
+        const bigint q = a / b;
+        const bigint r = a % b;
+        return q * b + r == a && r < bigint() && -r < b && bigint::factorial(200) % bigint::factorial(150) == bigint();
+    }
+
+    /**
+     * @brief Test if the remainder tree matches one modulo per modulus, and if CRT gives back the number
+     * @return True iff the remainders and the reconstruction are correct
+     */
+    static bool test_multi_mod_and_crt()
+    {
+        // 100 primes above one million
+        std::vector<bigint> moduli;
+        for (std::int64_t p = 1000003; moduli.size() < 100; p += 2)
+        {
+            bool prime = true;
+            for (std::int64_t d = 3; prime && d * d <= p; d += 2)
+                prime = p % d != 0;
+            if (prime)
+                moduli.emplace_back(p);
+        }
+
+        const bigint x = bigint::factorial(120) + bigint(12345);
+        bigint_remainder_tree tree(moduli);
+        const std::vector<bigint> remainders = tree.reduce(x);
+        for (std::size_t i = 0; i < moduli.size(); i++)
+        {
+            if (remainders[i] != x % moduli[i])
+                return false;
+        }
+
+        const std::vector<bigint> small{bigint(3), bigint(5), bigint(7)};
+        const std::vector<bigint> residues{bigint(2), bigint(3), bigint(2)};
+        return tree.combine(remainders) == x && tree.combine(remainders) == x && crt(residues, small) == bigint(23) &&
+               multi_mod(bigint(-1), small) == std::vector<bigint>{bigint(2), bigint(4), bigint(6)} &&
+               multi_mod(x, {}).empty() && crt({}, {}) == bigint();
+    }
+
+    /**
+     * @brief Test the remainder tree on moduli of very different sizes, an odd count and numbers far above the product
+     * @return True iff every remainder and every reconstruction is correct
+     */
+    static bool test_remainder_tree_mixed_sizes()
+    {
+        // Powers of distinct primes are pairwise coprime, with 1 to about 220 digits
+        const std::vector<std::int64_t> primes{2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73};
+        std::vector<bigint> moduli;
+        for (std::size_t i = 0; i < primes.size(); i++)
+        {
+            bigint power(primes[i]);
+            for (std::size_t e = 0; e < i * 53 % 120; e++)
+                power *= bigint(primes[i]);
+            moduli.push_back(power);
+        }
+
+        std::mt19937_64 rng(36);
+        bigint_remainder_tree tree(moduli);
+        const bigint product = tree.product();
+        const std::vector<bigint> numbers{bigint::random_below(product, rng),
+                                          -(product * product * bigint::random_digits(50, rng) + bigint(7))};
+        for (const bigint &x : numbers)
+        {
+            const std::vector<bigint> remainders = tree.reduce(x);
+            for (std::size_t i = 0; i < moduli.size(); i++)
+            {
+                bigint expected = x % moduli[i];
+                if (expected < bigint())
+                    expected += moduli[i];
+                if (remainders[i] != expected)
+                    return false;
+            }
+            bigint expected = x % product;
+            if (expected < bigint())
+                expected += product;
+            if (tree.combine(remainders) != expected)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Test if CRT rejects moduli that are not pairwise coprime and residue lists of the wrong length
+     * @return True iff both throw invalid_argument
+     */
+    static bool test_crt_errors()
+    {
+        const std::vector<bigint> moduli{bigint(4), bigint(6)};
+        const std::vector<bigint> residues{bigint(1), bigint(1)};
+        bool not_coprime = false;
+        bool wrong_length = false;
+        try
+        {
+            crt(residues, moduli);
+        }
+        catch (const std::invalid_argument &)
+        {
+            not_coprime = true;
+        }
+        try
+        {
+            crt(std::vector<bigint>{bigint(1)}, moduli);
+        }
+        catch (const std::invalid_argument &)
+        {
+            wrong_length = true;
+        }
+        return not_coprime && wrong_length;
+    }
+
+    /**
+     * @brief Test the greatest common divisor, including signs and zeros
+     * @return True iff all divisors are correct
+     */
+    static bool test_gcd()
+    {
+        constexpr bool compile_time = bigint::gcd(bigint(84), bigint(-36)) == bigint(12);
+        const bigint a = bigint::factorial(60);
+        const bigint b = bigint::primorial(100) * bigint(49);
+        return compile_time && bigint::gcd(a, b) == bigint::primorial(60) * bigint(49) &&
+               bigint::gcd(bigint(), bigint(-5)) == bigint(5) && bigint::gcd(bigint(), bigint()) == bigint() &&
+               bigint::gcd(bigint(17), bigint(13)) == bigint(1);
+    }
+
+    /**
+     * @brief Test the rational operators against hand-computed results in lowest terms
+     * @return True iff all results are correct
+     */
+    static bool test_rational_arithmetic()
+    {
+        const bigrational half(bigint(1), bigint(2));
+        const bigrational third(bigint(2), bigint(-6));
+        std::ostringstream printed;
+        printed << half + third << ' ' << half - third << ' ' << half * third << ' ' << half / third << ' '
+                << bigrational(bigint(10), bigint(5)) << ' ' << third;
+        return printed.str() == "1/6 5/6 -1/6 -3/2 2 -1/3" && (half * bigrational()) == bigrational() &&
+               third.numerator() == bigint(-1) && third.denominator() == bigint(3) && -half < third &&
+               third < half && half >= half && half != third && bigrational(bigint(3)) == bigrational(bigint(6), bigint(2));
+    }
+
+    /**
+     * @brief Test that a long sum of unreduced fractions stays bounded and matches the reduced sum
+     * @return True iff the harmonic number H(200) is the same both ways
+     */
+    static bool test_rational_lazy_sum()
+    {
+        bigrational reduced_sum;
+        bigrational lazy_sum;
+        for (int k = 1; k <= 200; k++)
+        {
+            reduced_sum += bigrational(bigint(1), bigint(k));
+            lazy_sum += bigrational(bigint(2 * k), bigint(2 * k * k)); // Not in lowest terms
+        }
+        // The denominator of H(200) divides lcm(1..200), which has 87 digits, far below the 375 digits of 200!
+        return lazy_sum == reduced_sum && reduced_sum.denominator().size_in_base(10) < 100;
+    }
+
+    /**
+     * @brief Test that several threads can compare, print and read the parts of the same unreduced const fraction, and
+     * that reduce() makes the same fraction reduced in place
+     * @return True iff every thread sees the lowest terms
+     */
+    static bool test_rational_const_reads()
+    {
+        bigrational value(bigint(-84), bigint(120));
+        const bigrational &shared = value;
+        const bigrational expected(bigint(-7), bigint(10));
+        std::vector<std::thread> readers;
+        std::vector<int> ok(4, 0);
+        for (std::size_t t = 0; t < ok.size(); t++)
+        {
+            readers.emplace_back(
+                [&, t]
+                {
+                    bool all = true;
+                    for (int i = 0; i < 200; i++)
+                    {
+                        std::ostringstream printed;
+                        printed << shared;
+                        all = all && printed.str() == "-7/10" && shared == expected && shared < bigrational() &&
+                              shared.numerator() == bigint(-7) && shared.denominator() == bigint(10);
+                    }
+                    ok[t] = all;
+                });
+        }
+        for (auto &reader : readers)
+            reader.join();
+
+        value.reduce();
+        return std::all_of(ok.begin(), ok.end(), [](int all) { return all != 0; }) && value == expected &&
+               bigrational(bigint(3), bigint(6)) * bigrational() == bigrational();
+    }
+
+    /**
+     * @brief Test that a zero denominator or divisor throws
+     * @return True iff both throw logic_error
+     */
+    static bool test_rational_division_by_zero()
+    {
+        bool zero_denominator = false;
+        bool zero_divisor = false;
+        try
+        {
+            bigrational(bigint(1), bigint());
+        }
+        catch (const std::logic_error &)
+        {
+            zero_denominator = true;
+        }
+        try
+        {
+            bigrational(bigint(1)) / bigrational(bigint(), bigint(3));
+        }
+        catch (const std::logic_error &)
+        {
+            zero_divisor = true;
+        }
+        return zero_denominator && zero_divisor;
+    }
+
+    /**
+     * @brief Test parsing, formatting and the exact operators of bigdecimal
+     * @return True iff all results and scales are correct
+     */
+    static bool test_decimal_exact_arithmetic()
+    {
+        const bigdecimal a("-1234.5678");
+        const bigdecimal b("0.05");
+        std::ostringstream printed;
+        printed << a << ' ' << a + b << ' ' << a - b << ' ' << a * b << ' ' << bigdecimal("+.5") << ' '
+                << bigdecimal("-0.000") << ' ' << bigdecimal(bigint(5), 3);
+        constexpr bool compile_time = bigint(7).multiply_pow10(3) == bigint(7000) && bigint(-7654).divide_pow10(2) == bigint(-76);
+        return printed.str() == "-1234.5678 -1234.5178 -1234.6178 -61.728390 0.5 0.000 0.005" && compile_time &&
+               a.scale() == 4 && a.unscaled_value() == bigint(-12345678) && bigdecimal("1.5") == bigdecimal("1.50") &&
+               bigdecimal("1.49") < bigdecimal("1.5") && bigdecimal("-2") < bigdecimal("-1.999") &&
+               bigint(123).divide_pow10(5) == bigint();
+    }
+
+    /**
+     * @brief Test every rounding mode when lowering the scale and when dividing
+     * @return True iff all rounded results are correct
+     */
+    static bool test_decimal_rounding()
+    {
+        using mode = bigdecimal::rounding_mode;
+        const std::vector<mode> modes{mode::down, mode::up, mode::half_up, mode::half_down, mode::half_even, mode::floor, mode::ceiling};
+        // Expected results for each mode, in the order above
+        const std::vector<std::pair<std::string, std::vector<std::string>>> cases{
+            {"2.5", {"2", "3", "3", "2", "2", "2", "3"}},
+            {"-2.5", {"-2", "-3", "-3", "-2", "-2", "-3", "-2"}},
+            {"3.5", {"3", "4", "4", "3", "4", "3", "4"}},
+            {"-1.51", {"-1", "-2", "-2", "-2", "-2", "-2", "-1"}},
+            {"0.4", {"0", "1", "0", "0", "0", "0", "1"}},
+            {"-0.4", {"0", "-1", "0", "0", "0", "-1", "0"}},
+            {"7.000", {"7", "7", "7", "7", "7", "7", "7"}},
+        };
+        for (const auto &[text, expected] : cases)
+        {
+            for (std::size_t i = 0; i < modes.size(); i++)
+            {
+                if (bigdecimal(text).rescale(0, modes[i]).to_string() != expected[i])
+                    return false;
+            }
+        }
+        return bigdecimal("1").divide(bigdecimal("3"), 5).to_string() == "0.33333" &&
+               bigdecimal("-2").divide(bigdecimal("3"), 2).to_string() == "-0.67" &&
+               bigdecimal("1.00").divide(bigdecimal("8"), 2).to_string() == "0.12" &&
+               bigdecimal("1.00").divide(bigdecimal("8"), 2, mode::half_up).to_string() == "0.13" &&
+               bigdecimal("10").divide(bigdecimal("0.25"), 0).to_string() == "40" &&
+               bigdecimal("123.456").divide(bigdecimal("-1"), 1, mode::floor).to_string() == "-123.5" &&
+               bigdecimal("-1234.5678").rescale(6).to_string() == "-1234.567800";
+    }
+
+    /**
+     * @brief Test that malformed strings and division by zero throw
+     * @return True iff every case throws the expected exception
+     */
+    static bool test_decimal_errors()
+    {
+        int thrown = 0;
+        for (const char *text : {"", "-", ".", "1.2.3", "12a", "1e5"})
+        {
+            try
+            {
+                bigdecimal value(text);
+            }
+            catch (const std::invalid_argument &)
+            {
+                thrown++;
+            }
+        }
+        try
+        {
+            bigdecimal("1").divide(bigdecimal("0.00"), 2);
+        }
+        catch (const std::logic_error &)
+        {
+            thrown++;
+        }
+        return thrown == 7;
+    }
+
+    /**
+     * @brief Test modular products and sums against operator% for a Montgomery modulus and a modulus divisible by 10
+     * @return True iff every chain of operations matches
+     */
+    static bool test_modint_matches_operators()
+    {
+        for (const bigint &modulus : {bigint::factorial(40) + bigint(1), bigint::factorial(40), bigint(1000000007)})
+        {
+            const std::shared_ptr<const modint_context> context = modint_context::create(modulus);
+            bigint a = bigint::primorial(97);
+            const bigint b = -bigint::factorial(33);
+            modint x(context, a);
+            const modint y(context, b);
+            for (int i = 0; i < 20; i++)
+            {
+                x = x * y + x - y;
+                a = ((a * b % modulus + a - b) % modulus + modulus) % modulus;
+            }
+            if (x.value() != a || x != modint(context, a) || context->uses_montgomery() != (modulus != bigint::factorial(40)))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Test powers and inverses, including Fermat's little theorem for a prime modulus
+     * @return True iff all results are correct
+     */
+    static bool test_modint_pow_and_inverse()
+    {
+        const std::shared_ptr<const modint_context> prime = modint_context::create(bigint(1000000007));
+        const modint g(prime, bigint(5));
+        const std::shared_ptr<const modint_context> composite = modint_context::create(bigint(1000));
+        const modint h(composite, bigint(-7));
+        std::ostringstream printed;
+        printed << g.pow(bigint(1000000006)) << ' ' << g.pow(bigint(123)) << ' ' << g * g.inverse() << ' ' << -g << ' '
+                << h << ' ' << h.pow(bigint(3)) << ' ' << h.inverse() << ' ' << h.pow(bigint());
+        return printed.str() == "1 927854675 1 1000000002 993 657 857 1" &&
+               bigint(-123456).modulo_pow10(3) == bigint(-456) && bigint(1002).modulo_pow10(2) == bigint(2) &&
+               bigint(5).modulo_pow10(0) == bigint();
+    }
+
+    /**
+     * @brief Test that bad moduli, mixed moduli and non-invertible values throw
+     * @return True iff every case throws invalid_argument
+     */
+    static bool test_modint_errors()
+    {
+        int thrown = 0;
+        const std::shared_ptr<const modint_context> ten = modint_context::create(bigint(10));
+        const std::shared_ptr<const modint_context> eleven = modint_context::create(bigint(11));
+        const std::vector<std::function<void()>> cases{
+            [] { modint_context context{bigint()}; },
+            [&] { modint(ten, bigint(1)) + modint(eleven, bigint(1)); },
+            [&] { modint(ten, bigint(4)).inverse(); },
+            [&] { modint(eleven, bigint(4)).pow(bigint(-1)); },
+        };
+        for (const std::function<void()> &run : cases)
+        {
+            try
+            {
+                run();
+            }
+            catch (const std::invalid_argument &)
+            {
+                thrown++;
+            }
+        }
+        return thrown == 4;
+    }
+
+    /**
+     * @brief Test the primality test against trial division, and Baillie-PSW against pseudoprimes of each half
+     * @return True iff every number is classified correctly
+     */
+    static bool test_probable_prime()
+    {
+        for (std::int64_t n = 4190000; n < 4191000; n++)
+        {
+            bool prime = true;
+            for (std::int64_t d = 2; prime && d * d <= n; d++)
+                prime = n % d != 0;
+            if (is_probable_prime(bigint(n)) != prime)
+                return false;
+        }
+
+        // 3825123056546413051 is a strong pseudoprime to every prime base up to 23, 5459 is a strong Lucas pseudoprime
+        const bigint spsp("3825123056546413051");
+        return bigint_primality::miller_rabin(spsp, bigint(2)) && !bigint_primality::strong_lucas(spsp) &&
+               !is_probable_prime(spsp) && bigint_primality::strong_lucas(bigint(5459)) &&
+               !bigint_primality::miller_rabin(bigint(5459), bigint(2)) &&
+               is_probable_prime(bigint("170141183460469231731687303715884105727"), 4) &&
+               !is_probable_prime(bigint("318665857834031151167461")) && is_probable_prime(bigint(2)) &&
+               is_probable_prime(bigint(2039)) && !is_probable_prime(bigint(1)) && !is_probable_prime(bigint(-7)) &&
+               !is_probable_prime(bigint(2047));
+    }
+
+    /**
+     * @brief Test next_prime across the trial division bound and on a 101-digit number
+     * @return True iff the primes found are the next ones
+     */
+    static bool test_next_prime_and_powmod()
+    {
+        const bigint googol = bigint(1).multiply_pow10(100);
+        return next_prime(bigint(-5)) == bigint(2) && next_prime(bigint(2)) == bigint(3) &&
+               next_prime(bigint(4194301)) == bigint(4194319) && next_prime(googol) == googol + bigint(267) &&
+               powmod(bigint(-3), bigint(1000), bigint(1000)) == bigint(1) &&
+               powmod(bigint(2), bigint(100), bigint(1000000)) == bigint(205376) &&
+               powmod(bigint(7), bigint(), bigint(1)) == bigint();
+    }
+
+    /**
+     * @brief Test that random numbers stay in range, cover it evenly and follow the seed
+     * @return True iff every draw is in range and each value of a small range is drawn about equally often
+     */
+    static bool test_random_generation_ranges()
+    {
+        std::mt19937_64 rng(46);
+        std::vector<int> below_seven(7, 0);
+        std::vector<int> three_bits(8, 0);
+        for (int i = 0; i < 14000; i++)
+        {
+            below_seven[static_cast<std::size_t>(bigint::random_below(bigint(7), rng).to_int64())]++;
+            three_bits[static_cast<std::size_t>(bigint::random_bits(3, rng).to_int64())]++;
+        }
+        // Each count is about 2000 or 1750 with a standard deviation below 50
+        for (const int count : below_seven)
+        {
+            if (count < 1750 || count > 2250)
+                return false;
+        }
+        for (const int count : three_bits)
+        {
+            if (count < 1500 || count > 2000)
+                return false;
+        }
+
+        const bigint bound("1000000000000000000001");
+        const bigint two_to_100 = bigint("1267650600228229401496703205376");
+        for (int i = 0; i < 1000; i++)
+        {
+            const bigint x = bigint::random_below(bound, rng);
+            const bigint y = bigint::random_bits(100, rng);
+            if (x < bigint() || x >= bound || y < bigint() || y >= two_to_100 ||
+                bigint::random_digits(30, rng).size_in_base(10) > 30)
+                return false;
+        }
+
+        std::mt19937 first(7);
+        std::mt19937 second(7);
+        return bigint::random_below(bound, first) == bigint::random_below(bound, second) &&
+               bigint::random_bits(0, first) == bigint() && bigint::random_digits(0, first) == bigint() &&
+               bigint::random_below(bigint(1), first) == bigint();
+    }
+
+    /**
+     * @brief Test that a bound that is not positive throws
+     * @return True iff both bounds throw invalid_argument
+     */
+    static bool test_random_generation_errors()
+    {
+        std::minstd_rand rng(1);
+        int thrown = 0;
+        for (const bigint &bound : {bigint(), bigint(-5)})
+        {
+            try
+            {
+                bigint::random_below(bound, rng);
+            }
+            catch (const std::invalid_argument &)
+            {
+                thrown++;
+            }
+        }
+        return thrown == 2;
+    }
+
+    /**
+     * @brief Test that copies share the digits and that a change copies them only while they are shared
+     * @return True iff the reference counts, addresses and values are as expected
+     */
+    static bool test_shared_copy_on_write()
+    {
+        const shared_bigint a(bigint::factorial(100));
+        shared_bigint b = a;
+        const bool shared = a.use_count() == 2 && &a.value() == &b.value();
+
+        b += bigint(1);
+        const bool detached = a.use_count() == 1 && b.use_count() == 1 && a.value() == bigint::factorial(100);
+
+        // Not shared any more, so the change is made in place
+        const bigint *address = &b.value();
+        b *= bigint(3);
+        const bool in_place = &b.value() == address;
+
+        const shared_bigint old = b++;
+        const bigint expected = (bigint::factorial(100) + bigint(1)) * bigint(3);
+        return shared && detached && in_place && old.value() == expected && b == old + bigint(1) &&
+               (a + b).value() == a.value() + b.value() && -(-a) == a && b.mutable_value() == expected + bigint(1) &&
+               std::hash<shared_bigint>()(a) == std::hash<bigint>()(bigint::factorial(100));
+    }
+
+    /**
+     * @brief Test compound operators with the handle itself as the right-hand side, both unshared and shared
+     * @return True iff every result matches the same operation on plain bigint values
+     */
+    static bool test_shared_self_assignment()
+    {
+        const bigint x("-123456789012345678901234567890");
+        bool all = true;
+        for (bool share : {false, true})
+        {
+            shared_bigint s(x);
+            shared_bigint other = s;
+            if (!share)
+                other = shared_bigint();
+
+            s += s;
+            all = all && s.value() == x + x;
+            s -= s;
+            all = all && s.value() == bigint();
+
+            s = shared_bigint(x);
+            other = share ? s : shared_bigint();
+            s *= s;
+            all = all && s.value() == x * x;
+            s /= s;
+            all = all && s.value() == bigint(1);
+
+            s = shared_bigint(x);
+            other = share ? s : shared_bigint();
+            s %= s;
+            all = all && s.value() == bigint() && (!share || other.value() == x);
+            const shared_bigint &alias = s;
+            s = alias;
+            all = all && s.use_count() == 1 && s.value() == bigint();
+        }
+        return all;
+    }
+
+    /**
+     * @brief Test that several threads can copy and read the same handle while changing their own copies
+     * @return True iff every thread sees the original value
+     */
+    static bool test_shared_concurrent_readers()
+    {
+        const shared_bigint base(bigint::primorial(500));
+        std::vector<int> matches(4, 0);
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < matches.size(); t++)
+        {
+            threads.emplace_back(
+                [&base, &matches, t]
+                {
+                    for (int i = 0; i < 200; i++)
+                    {
+                        shared_bigint copy = base;
+                        copy += bigint(i);
+                        matches[t] += (copy - bigint(i)) == base;
+                    }
+                });
+        }
+        for (std::thread &thread : threads)
+            thread.join();
+        return base.use_count() == 1 && std::count(matches.begin(), matches.end(), 200) == 4;
+    }
+
+    /**
+     * @brief Remainders of a huge number by a few word-sized primes, to check a result much faster than computing it
+     * sequentially
+     * @param num The number
+     * @return The least non-negative remainders by 1000000007, 998244353 and 2147483647
+     */
+    static std::vector<std::int64_t> modulo_primes(const bigint &num)
+    {
+        std::vector<std::int64_t> result;
+        for (const std::int64_t p : {1000000007, 998244353, 2147483647})
+        {
+            bigint remainder = num % bigint(p);
+            if (remainder < bigint())
+                remainder += bigint(p);
+            result.push_back(remainder.to_int64());
+        }
+        return result;
     }
 
     /**
-     * @brief Test if the division assignment operator correctly divides two negative numbers
-     * @return True iff the result is correct
+     * @brief Test that the parallel multiplication matches the operator for balanced and unbalanced signed factors
+     * @return True iff the products have the expected remainders
      */
-    static bool test_division_assignment_all_negative()
+    static bool test_parallel_multiply()
     {
-        bigint num1(-456);
-        const bigint num2(-123);
-        num1 /= num2;
-        const auto expected = bigint(-456 / -123);
-        return num1 == expected;
+        std::mt19937_64 rng(48);
+        const bigint a = bigint::random_digits(70000, rng);
+        const bigint b = -bigint::random_digits(66000, rng);
+        const bigint c = bigint::random_digits(33000, rng);
+        const std::vector<std::int64_t> ra = modulo_primes(a);
+        const std::vector<std::int64_t> rb = modulo_primes(b);
+        const std::vector<std::int64_t> rc = modulo_primes(c);
+        const std::vector<std::int64_t> primes{1000000007, 998244353, 2147483647};
+        std::vector<std::int64_t> ab;
+        std::vector<std::int64_t> ca;
+        for (std::size_t i = 0; i < primes.size(); i++)
+        {
+            ab.push_back(ra[i] * rb[i] % primes[i]); // Below 2^62
+            ca.push_back(rc[i] * ra[i] % primes[i]);
+        }
+        return modulo_primes(bigint_parallel::multiply(a, b, 4)) == ab &&
+               modulo_primes(bigint_parallel::multiply(a, b, 2)) == ab &&
+               modulo_primes(bigint_parallel::multiply(c, a, 3)) == ca &&
+               bigint_parallel::multiply(a, bigint(), 4) == bigint();
     }
 
     /**
-     * @brief Test if the division assignment operator correctly divides a positive and a negative number
-     * @return True iff the result is correct
+     * @brief Test that the parallel conversions round-trip in base 10, parse base 16 and reject bad chars like the
+     * constructor, including sign chars at a split
+     * @return True iff every string and number is correct
      */
-    static bool test_division_assignment_positive_negative()
+    static bool test_parallel_conversion()
     {
-        bigint num1(456);
-        const bigint num2(-123);
-        num1 /= num2;
-        const auto expected = bigint(456 / -123);
-        return num1 == expected;
+        std::mt19937_64 rng(480);
+        const bigint decimal = -bigint::random_digits(300000, rng);
+        const std::string text = decimal.to_string();
+        if (bigint_parallel::to_string(decimal, 10, 4) != text || bigint_parallel::parse(text, 10, 4) != decimal ||
+            bigint_parallel::parse("-0012", 10, 4) != bigint(-12))
+            return false;
+
+        // The expected remainders of the hex number are folded in char by char
+        std::string hex_text = "+";
+        std::vector<std::int64_t> expected(3, 0);
+        const std::vector<std::int64_t> primes{1000000007, 998244353, 2147483647};
+        for (int i = 0; i < 70000; i++)
+        {
+            const int digit = static_cast<int>(rng() % 16);
+            hex_text.push_back("0123456789ABCDEF"[digit]);
+            for (std::size_t k = 0; k < primes.size(); k++)
+                expected[k] = (expected[k] * 16 + digit) % primes[k];
+        }
+        if (modulo_primes(bigint_parallel::parse(hex_text, 16, 4)) != expected)
+            return false;
+
+        // A sign char where the high and low parts of a base 16 string are split
+        std::string bad_hex(70000, 'f');
+        std::vector<std::string> bad{text, bad_hex, bad_hex};
+        bad[0][200000] = 'x';
+        bad[1][70000 - 32768] = '-';
+        bad[2][70000 - 32768] = '+';
+        for (std::size_t i = 0; i < bad.size(); i++)
+        {
+            try
+            {
+                bigint_parallel::parse(bad[i], i == 0 ? 10 : 16, 4);
+                return false;
+            }
+            catch (const std::invalid_argument &)
+            {
+            }
+        }
+        return true;
     }
 
     /**
-     * @brief Test if the division assignment operator correctly divides a negative and a positive number
-     * @return True iff the result is correct
+     * @brief Test that a stop request reaches the parts of parallel operations on other threads
+     * @return True iff every operation throws bigint_cancelled
      */
-    static bool test_division_assignment_negative_positive()
+    static bool test_parallel_cancellation()
     {
-        bigint num1(-456);
-        const bigint num2(123);
-        num1 /= num2;
-        const auto expected = bigint(-456 / 123);
-        return num1 == expected;
+        std::mt19937_64 rng(4801);
+        const bigint a = bigint::random_digits(70000, rng);
+        const std::string hex_text(70000, 'f');
+        const auto cancelled = [](auto task)
+        {
+            try
+            {
+                task();
+            }
+            catch (const bigint_cancelled &)
+            {
+                return true;
+            }
+            return false;
+        };
+
+        std::stop_source source;
+        source.request_stop();
+        bigint_control control(source.get_token());
+        const bigint_control::activation active(control);
+
+        // A worker control made on this thread stops another thread
+        bigint_control worker = bigint_control::for_worker();
+        std::future<bool> part = std::async(std::launch::async,
+                                            [&]
+                                            {
+                                                const bigint_control::activation inner(worker);
+                                                return cancelled([&] { return a * a; });
+                                            });
+        return part.get() && cancelled([&] { return bigint_parallel::multiply(a, a, 2); }) &&
+               cancelled([&] { return bigint_parallel::multiply(a, a, 4); }) &&
+               cancelled([&] { return bigint_parallel::parse(hex_text, 16, 4); });
     }
 
     /**
-     * @brief Test if the division assignment operator correctly divides zero and a number
-     * @return True iff the result is zero
+     * @brief Test if the accumulator gives the same sum as repeated addition, subtraction and multiplication
+     * @return True iff the sums are equal
      */
-    static bool test_division_assignment_zero()
+    static bool test_accumulator_matches_operators()
     {
-        bigint num1(0);
-        const bigint num2(-123);
-        num1 /= num2;
-        const auto expected = bigint(0);
-        return num1 == expected;
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<std::int64_t> dist(-999999999999, 999999999999);
+        bigint_accumulator acc;
+        bigint expected;
+        for (int i = 0; i < 2000; i++)
+        {
+            const bigint a(dist(rng));
+            const bigint b(dist(rng));
+            acc.add(a);
+            acc.sub(b);
+            acc.addmul(a, b);
+            expected += a;
+            expected -= b;
+            expected += a * b;
+        }
+        return acc.value() == expected;
     }
 
     /**
-     * @brief Test if the division assignment operator correctly divides by 1
-     * @return True iff the result is correct
+     * @brief Test if reading a negative running total again and again keeps the same number of lanes
+     * @return True iff every read gives the sum and the lane count does not grow
      */
-    static bool test_division_assignment_one()
+    static bool test_accumulator_repeated_reads()
     {
-        bigint num1(123);
-        const bigint num2(1);
-        num1 /= num2;
-        const auto expected = bigint(123 / 1);
-        return num1 == expected;
+        bigint_accumulator acc;
+        acc.sub(bigint("123456789"));
+        acc.value();
+        const std::size_t lanes = acc.lane_count();
+        for (int i = 0; i < 100; i++)
+        {
+            if (acc.value() != bigint(-123456789) || acc.lane_count() != lanes)
+                return false;
+        }
+        return true;
     }
 
     /**
-     * @brief Test if the division assignment operator correctly divides two same number
-     * @return
+     * @brief Test if the accumulator handles sums that are negative or exactly a power of ten
+     * @return True iff the sums are correct
      */
-    static bool test_division_assignment_same()
+    static bool test_accumulator_signs()
     {
-        bigint num1(123);
-        const bigint num2(123);
-        num1 /= num2;
-        const auto expected = bigint(1);
-        return num1 == expected;
+        bigint_accumulator acc;
+        acc.sub(bigint(10));
+        const bigint minus_ten = acc.value();
+        acc.add(bigint(10));
+        const bigint zero = acc.value();
+        acc.addmul(bigint("-99999999999999999999"), bigint("99999999999999999999"));
+        acc.add(bigint("9999999999999999999800000000000000000000"));
+        const bigint minus_one = acc.value();
+        acc.clear();
+        return minus_ten == bigint(-10) && zero == bigint() && minus_one == bigint(-1) && acc.value() == bigint();
     }
 
     /**
-     * @brief Test if the division assignment operator triggers an exception when dividing by zero
-     * @return True iff the exception is thrown
+     * @brief Test if equal numbers hash equally regardless of how they were built and the capacity of their buffers
+     * @return True iff the hashes are equal
      */
-    static bool test_division_assignment_division_by_zero()
+    static bool test_hash_equal_values()
     {
-        bigint num1(123);
-        const bigint num2(0);
-        try
-        {
-            num1 /= num2;
-            return false;
-        }
-        catch (const std::logic_error &)
-        {
-            return true;
-        }
+        const bigint a("123456789012345678901234567890");
+        bigint b("-123456789012345678901234567890");
+        b *= bigint(-1);
+        bigint c("999999999999999999999999999999999999999999999999999999999999");
+        c -= c;
+        const std::hash<bigint> hasher;
+        return hasher(a) == hasher(b) && hasher(c) == hasher(bigint()) && hasher(a) != hasher(-a);
     }
 
     /**
-     * @brief Test if the addition operator correctly returns the sum of two positive numbers without modifying the original numbers
-     * @return True iff the original numbers are not modified and the returned number is correct
+     * @brief Test if bigint and hashed_bigint work as keys of unordered containers
+     * @return True iff the lookups find the stored values
      */
-    static bool test_addition_operator_properties()
+    static bool test_hash_unordered_map()
     {
-        const bigint num1(123);
-        const bigint num2(456);
-        const auto result = num1 + num2;
-        const auto expected = bigint(123 + 456);
-        return result == expected && num1 == bigint(123) && num2 == bigint(456);
+        std::unordered_map<bigint, int> plain;
+        std::unordered_map<hashed_bigint, int> cached;
+        for (int i = -50; i < 50; i++)
+        {
+            plain[bigint(i) * bigint("100000000000000000000")] = i;
+            cached[hashed_bigint(bigint(i) * bigint("100000000000000000000"))] = i;
+        }
+        return plain.size() == 100 && cached.size() == 100 && plain.at(bigint("-4200000000000000000000")) == -42 &&
+               cached.at(hashed_bigint(bigint("4200000000000000000000"))) == 42;
     }
 
     /**
-     * @brief Test if the subtraction operator correctly returns the difference of two numbers without modifying the original numbers
-     * @return True iff the original numbers are not modified and the returned number is correct
+     * @brief Test if a number survives a round trip through a byte buffer in the binary format
+     * @return True iff the deserialized number equals the original number
      */
-    static bool test_subtraction_operator_properties()
+    static bool test_serialize_buffer_round_trip()
     {
-        const bigint num1(456);
-        const bigint num2(123);
-        const auto result = num1 - num2;
-        const auto expected = bigint(456 - 123);
-        return result == expected && num1 == bigint(456) && num2 == bigint(123);
+        const bigint num("-123456789012345678901234567890123456789");
+        std::vector<std::byte> buffer(num.serialized_size());
+        const std::size_t written = num.serialize(buffer);
+        return written == 16 + 8 * 3 && bigint::deserialize(buffer) == num;
     }
 
     /**
-     * @brief Test if the multiplication operator correctly returns the product of two numbers without modifying the original numbers
-     * @return True iff the original numbers are not modified and the returned number is correct
+     * @brief Test if a number survives a round trip through a stream in the binary format
+     * @return True iff the deserialized number equals the original number
      */
-    static bool test_multiplication_operator_properties()
+    static bool test_serialize_stream_round_trip()
     {
-        const bigint num1(123);
-        const bigint num2(456);
-        const auto result = num1 * num2;
-        const auto expected = bigint(123 * 456);
-        return result == expected && num1 == bigint(123) && num2 == bigint(456);
+        const bigint num("98765432109876543210987654321");
+        const bigint zero;
+        std::stringstream stream;
+        num.serialize(stream);
+        zero.serialize(stream);
+        return bigint::deserialize(stream) == num && bigint::deserialize(stream) == zero;
     }
 
     /**
-     * @brief Test if the division operator correctly returns the quotient of two numbers without modifying the original numbers
-     * @return True iff the original numbers are not modified and the returned number is correct
+     * @brief Test if a view reads the number straight out of the buffer
+     * @return True iff the view compares equal to the original number and prints the same digits
      */
-    static bool test_division_operator_properties()
+    static bool test_serialize_view()
     {
-        const bigint num1(456);
-        const bigint num2(123);
-        const auto result = num1 / num2;
-        const auto expected = bigint(456 / 123);
-        return result == expected && num1 == bigint(456) && num2 == bigint(123);
+        const bigint num("-10000000000000000000000000000000000000001");
+        std::vector<std::byte> buffer(num.serialized_size());
+        num.serialize(buffer);
+
+        const bigint_view view(buffer);
+        std::ostringstream expected;
+        std::ostringstream actual;
+        expected << num;
+        actual << view;
+        return view.is_negative() && num == view && view.to_bigint() == num && actual.str() == expected.str();
     }
 
     /**
-     * @brief Test if the inequality operator correctly compares two different numbers
-     * @return True iff the two numbers are not equal
+     * @brief Test if deserialization rejects buffers that are not in the binary format
+     * @return True iff the exception is thrown
      */
-    static bool test_inequality_operator()
+    static bool test_serialize_invalid()
     {
-        const bigint num1(123);
-        const bigint num2(456);
-        return num1 != num2;
+        const std::vector<std::byte> buffer(16, std::byte{0});
+        try
+        {
+            bigint::deserialize(buffer);
+            return false;
+        }
+        catch (const std::invalid_argument &)
+        {
+            return true;
+        }
     }
 
     /**
-     * @brief Test if the less than operator correctly compares two positive numbers
-     * @return True iff the first number is less than the second number
+     * @brief Test if limb payloads with a lying count or a zero top limb are rejected by the stream, buffer and view
+     * @return True iff every payload throws invalid_argument instead of overflowing a buffer
      */
-    static bool test_less_than_operator_all_positive()
+    static bool test_serialize_untrusted_limbs()
     {
-        const bigint num1(123);
-        const bigint num2(456);
-        return num1 < num2;
+        const auto throws = [](auto action)
+        {
+            try
+            {
+                action();
+            }
+            catch (const std::invalid_argument &)
+            {
+                return true;
+            }
+            return false;
+        };
+        const auto set_count = [](std::vector<std::byte> &buffer, std::uint64_t count)
+        {
+            for (std::size_t i = 0; i < 8; i++)
+                buffer[8 + i] = static_cast<std::byte>(count >> (8 * i));
+        };
+
+        // A count whose digit total wraps around size_t, followed by far fewer limbs than it claims
+        std::vector<std::byte> lying(bigint(1).serialized_size());
+        bigint(1).serialize(lying);
+        lying.resize(4112, std::byte{0x01});
+        set_count(lying, 970881267037344822ULL);
+        const std::string lying_text(reinterpret_cast<const char *>(lying.data()), lying.size());
+
+        // A valid two-limb number with an extra zero limb on top
+        const bigint num("12345678901234567890123");
+        std::vector<std::byte> padded(num.serialized_size());
+        num.serialize(padded);
+        padded.resize(padded.size() + 8, std::byte{0});
+        set_count(padded, 3);
+        const std::string padded_text(reinterpret_cast<const char *>(padded.data()), padded.size());
+
+        return throws([&] { std::istringstream stream(lying_text); bigint::deserialize(stream); }) &&
+               throws([&] { bigint::deserialize(lying); }) &&
+               throws([&] { std::istringstream stream(padded_text); bigint::deserialize(stream); }) &&
+               throws([&] { bigint::deserialize(padded); }) && throws([&] { bigint_view view(padded); });
     }
 
     /**
-     * @brief Test if the less than operator correctly compares two negative numbers
-     * @return True iff the first number is less than the second number
+     * @brief Test if digit images with a huge count or an out-of-range interior digit are rejected by every entry point
+     * @return True iff every image throws invalid_argument, and a view of a bad image fails validation
      */
-    static bool test_less_than_operator_all_negative()
+    static bool test_serialize_untrusted_digits()
     {
-        const bigint num1(-456);
-        const bigint num2(-123);
-        return num1 < num2;
+        const auto throws = [](auto action)
+        {
+            try
+            {
+                action();
+            }
+            catch (const std::invalid_argument &)
+            {
+                return true;
+            }
+            return false;
+        };
+        std::vector<std::byte> bad(bigint(10).serialized_size(bigint::binary_encoding::digits));
+        bigint(10).serialize(bad, bigint::binary_encoding::digits);
+        bad[16] = std::byte{12}; // The image {12, 1} would print as "1<"
+
+        // Counts near 2^40 and above 2^63 must fail as truncated, not as bad_alloc or a hang in the scratch pool
+        bool truncated = true;
+        for (std::uint64_t count : {std::uint64_t{1} << 40, (std::uint64_t{1} << 63) + 5})
+        {
+            std::vector<std::byte> huge = bad;
+            huge[16] = std::byte{1};
+            for (std::size_t i = 0; i < 8; i++)
+                huge[8 + i] = static_cast<std::byte>(count >> (8 * i));
+            const std::string text(reinterpret_cast<const char *>(huge.data()), huge.size());
+            truncated = truncated && throws([&] { std::istringstream stream(text); bigint::deserialize(stream); });
+        }
+
+        const auto path = (std::filesystem::temp_directory_path() / "bigint_test_bad_digits.bin").string();
+        {
+            std::ofstream file(path, std::ios::binary);
+            file.write(reinterpret_cast<const char *>(bad.data()), static_cast<std::streamsize>(bad.size()));
+        }
+        const bool mapped = throws([&] { mapped_bigint file(path); });
+        std::filesystem::remove(path);
+
+        const bigint_view view(bad);
+        return truncated && mapped && throws([&] { bigint::deserialize(bad); }) && throws([&] { view.validate(); });
     }
 
     /**
-     * @brief Test if the less than operator correctly compares a positive and a negative number
-     * @return True if the first number if negative
+     * @brief Test if byte import and export match the value of the bytes in both byte orders
+     * @return True iff the conversions are correct
      */
-    static bool test_less_than_operator_mixed()
+    static bool test_bytes_import_export()
     {
-        const bigint num1(-123);
-        const bigint num2(123);
-        return num1 < num2;
+        const std::vector<std::byte> big_endian{std::byte{0x01}, std::byte{0x00}, std::byte{0x00}, std::byte{0x00},
+                                                std::byte{0x00}, std::byte{0x00}, std::byte{0x00}, std::byte{0x00},
+                                                std::byte{0x00}};
+        const bigint num = bigint::from_bytes(big_endian);
+        const auto little_endian = num.to_bytes(std::endian::little);
+        return num == bigint("18446744073709551616") && num.to_bytes() == big_endian &&
+               bigint::from_bytes(little_endian, std::endian::little) == num && bigint().to_bytes().empty();
     }
 
     /**
-     * @brief Test if the less than or equal operator correctly compares two same numbers
-     * @return True iff the two numbers are equal
+     * @brief Test if a number saved as a digit image can be mapped and used as an operand in place
+     * @return True iff the results with the mapped operand match the results with the original number
      */
-    static bool test_less_than_equal_operator_equal()
+    static bool test_mapped_digit_image_operand()
     {
-        const bigint num1(123);
-        const bigint num2(123);
-        return num1 <= num2;
+        const auto path = (std::filesystem::temp_directory_path() / "bigint_test_digits.bin").string();
+        const bigint num("-123456789012345678901234567890");
+        save_bigint(path, num);
+
+        bool result;
+        {
+            const mapped_bigint mapped(path);
+            const bigint_view view = mapped.view();
+
+            bigint sum(1000);
+            bigint product(-3);
+            bigint quotient("-1234567890123456789012345678900");
+            sum += view;
+            product *= view;
+            quotient /= view;
+            result = view.encoding() == bigint::binary_encoding::digits && num == view &&
+                     sum == bigint(1000) + num && product == bigint(-3) * num && quotient == bigint(10);
+        }
+        std::filesystem::remove(path);
+        return result;
     }
 
     /**
-     * @brief Test if the less than or equal operator correctly compares negative number and zero
-     * @return True iff the first number is negative
+     * @brief Test if a number saved in the compact encoding can be mapped, used as an operand and loaded back
+     * @return True iff the results match the original number
      */
-    static bool test_less_than_equal_operator_less_than()
+    static bool test_mapped_limbs_round_trip()
     {
-        const bigint num1(-456);
-        const bigint num2(0);
-        return num1 <= num2;
+        const auto path = (std::filesystem::temp_directory_path() / "bigint_test_limbs.bin").string();
+        const bigint num("98765432109876543210987654321098765432109876543210");
+        save_bigint(path, num, bigint::binary_encoding::limbs);
+
+        bool result;
+        {
+            const mapped_bigint mapped(path);
+            bigint diff = num;
+            diff -= mapped.view();
+            result = mapped.view().encoding() == bigint::binary_encoding::limbs && diff == bigint(0) &&
+                     load_bigint(path) == num;
+        }
+        std::filesystem::remove(path);
+        return result;
     }
 
     /**
-     * @brief Test greater than operator correctly compares two number
-     * @return True iff the first number is greater than the second number
+     * @brief Test if the extraction operator reads whitespace-separated numbers and stops at the first non-digit char
+     * @return True iff the numbers are read correctly
      */
-    static bool test_greater_than_operator()
+    static bool test_extraction_operator()
     {
-        const bigint num1(123);
-        const bigint num2(0);
-        return num1 > num2;
+        std::istringstream stream("  -000123456789012345678901234567890 +42\n7x");
+        bigint a;
+        bigint b;
+        bigint c;
+        stream >> a >> b >> c;
+        const char next = static_cast<char>(stream.get());
+        return stream.good() && a == bigint("-123456789012345678901234567890") && b == bigint(42) && c == bigint(7) &&
+               next == 'x';
     }
 
     /**
-     * @brief Test greater than or equal operator correctly compares two equal numbers
-     * @return True iff the two numbers are equal
+     * @brief Test if the extraction operator sets failbit without digits and leaves the number unchanged
+     * @return True iff the stream fails and the number is unchanged
      */
-    static bool test_greater_than_equal_operator()
+    static bool test_extraction_operator_sign_only()
     {
-        const bigint num1(123);
-        const bigint num2(123);
-        return num1 >= num2;
+        std::istringstream stream("- 5");
+        bigint num(9);
+        stream >> num;
+        return stream.fail() && num == bigint(9);
     }
 
     /**
-     * @brief Test if the insertion operator correctly sends the positive number to the output stream
-     * @return True if the two strings are equal
+     * @brief Test if the extraction operator reads a number longer than one block
+     * @return True iff the number is read correctly
      */
-    static bool test_insertion_operator_positive()
+    static bool test_extraction_operator_long()
     {
-        const bigint num(123);
-        std::ostringstream stream;
-        stream << num;
-        return stream.str() == "123";
+        const std::string text = "9" + std::string(10000, '0') + "1";
+        std::istringstream stream(text);
+        bigint num;
+        stream >> num;
+        return stream.eof() && !stream.fail() && num == bigint(text);
     }
 
     /**
-     * @brief Test if the insertion operator correctly sends the negative number to the output stream
-     * @return True if the two strings are equal
+     * @brief Test if the chunked parser gives the same result no matter where the text is split
+     * @return True iff every split gives the same number
      */
-    static bool test_insertion_operator_negative()
+    static bool test_parser_chunks()
     {
-        const bigint num(-123);
-        std::ostringstream stream;
-        stream << num;
-        return stream.str() == "-123";
+        const std::string text = "-00098765432109876543210";
+        const bigint expected(text);
+        for (std::size_t split = 0; split <= text.size(); split++)
+        {
+            bigint_parser parser;
+            parser.feed(std::string_view(text).substr(0, split));
+            parser.feed(std::string_view(text).substr(split));
+            if (parser.finish() != expected)
+                return false;
+        }
+        return true;
     }
 
     /**
-     * @brief Test if the insertion operator correctly sends zero to the output stream
-     * @return True if the two strings are equal
+     * @brief Test if the chunked parser reports the same errors as the string constructor
+     * @return True iff every invalid input throws
      */
-    static bool test_insertion_operator_zero()
+    static bool test_parser_errors()
     {
-        const bigint num(0);
-        std::ostringstream stream;
-        stream << num;
-        return stream.str() == "0";
+        for (const std::string_view text : {"", "+", "12a3", "1-2"})
+        {
+            try
+            {
+                bigint_parser parser;
+                parser.feed(text);
+                parser.finish();
+                return false;
+            }
+            catch (const std::invalid_argument &)
+            {
+            }
+        }
+        return true;
     }
 
     /**
@@ -1260,6 +3065,7 @@ public:
         run_test("Test Multiplication Assignment Zero * Negative", test_multiplication_assignment_zero_negative);
         run_test("Test Multiplication Assignment with Max Int64", test_multiplication_assignment_max);
         run_test("Test Multiplication Assignment with Min Int64", test_multiplication_assignment_min);
+        run_test("Test Karatsuba Matches Rows", test_karatsuba_matches_rows);
 
         std::cout << "\nDivision Assignment Operator Tests:" << std::endl;
         run_test("Test Division Assignment Positive / Positive", test_division_assignment_all_positive);
@@ -1290,6 +3096,122 @@ public:
         run_test("Test Insertion Operator Negative", test_insertion_operator_negative);
         run_test("Test Insertion Operator Zero", test_insertion_operator_zero);
 
+        std::cout << "\nExtraction Operator Tests:" << std::endl;
+        run_test("Test Extraction Operator", test_extraction_operator);
+        run_test("Test Extraction Operator Sign Only", test_extraction_operator_sign_only);
+        run_test("Test Extraction Operator Longer Than One Block", test_extraction_operator_long);
+        run_test("Test Parser with Chunks", test_parser_chunks);
+        run_test("Test Parser Errors", test_parser_errors);
+
+        std::cout << "\nConstexpr Tests:" << std::endl;
+        run_test("Test Constexpr Arithmetic", test_constexpr_arithmetic);
+        run_test("Test Constexpr Literal", test_constexpr_literal);
+
+        std::cout << "\nFixed-Width Tests:" << std::endl;
+        run_test("Test Fixed Arithmetic", test_fixed_arithmetic);
+        run_test("Test Fixed Division", test_fixed_division);
+        run_test("Test Fixed Wrapping Mode", test_fixed_wrap);
+        run_test("Test Fixed Checked Mode", test_fixed_checked);
+
+        std::cout << "\nFused Multiply-Add Tests:" << std::endl;
+        run_test("Test Addmul and Submul", test_addmul_submul);
+        run_test("Test Addmul Edge Cases", test_addmul_edge_cases);
+
+        std::cout << "\nAsync Tests:" << std::endl;
+        run_test("Test Async Results and Progress", test_async_results_and_progress);
+        run_test("Test Async Cancellation", test_async_cancellation);
+
+        std::cout << "\nInstrumentation Tests:" << std::endl;
+        run_test("Test Instrumentation Snapshot", test_instrumentation_snapshot);
+        run_test("Test Scratch Pool Reuse", test_scratch_pool_reuse);
+
+        std::cout << "\nNative Conversion Tests:" << std::endl;
+        run_test("Test Native Integer Conversions", test_native_integer_conversions);
+        run_test("Test To Double", test_to_double);
+        run_test("Test Size Estimates", test_size_estimates);
+
+        std::cout << "\nRadix Conversion Tests:" << std::endl;
+        run_test("Test Radix Round Trip", test_radix_round_trip);
+        run_test("Test Radix Errors", test_radix_errors);
+
+        std::cout << "\nCharacter Conversion Tests:" << std::endl;
+        run_test("Test String View Parsing", test_string_view_parsing);
+        run_test("Test From Chars", test_from_chars);
+        run_test("Test Formatted Size", test_formatted_size);
+        run_test("Test To Chars", test_to_chars);
+#ifdef __cpp_lib_format
+        run_test("Test Formatter", test_formatter);
+#endif
+
+        std::cout << "\nModulo Tests:" << std::endl;
+        run_test("Test Division and Modulo Signs", test_division_and_modulo_signs);
+        run_test("Test Long Division Identity", test_long_division_identity);
+        run_test("Test Multi Mod and CRT", test_multi_mod_and_crt);
+        run_test("Test Remainder Tree Mixed Sizes", test_remainder_tree_mixed_sizes);
+        run_test("Test CRT Errors", test_crt_errors);
+
+        std::cout << "\nCombinatorics Tests:" << std::endl;
+        run_test("Test Factorial", test_factorial);
+        run_test("Test Binomial", test_binomial);
+        run_test("Test Primorial and Product", test_primorial_and_product);
+
+        std::cout << "\nRational Tests:" << std::endl;
+        run_test("Test GCD", test_gcd);
+        run_test("Test Rational Arithmetic", test_rational_arithmetic);
+        run_test("Test Rational Lazy Sum", test_rational_lazy_sum);
+        run_test("Test Rational Const Reads", test_rational_const_reads);
+        run_test("Test Rational Division by Zero", test_rational_division_by_zero);
+
+        std::cout << "\nDecimal Tests:" << std::endl;
+        run_test("Test Decimal Exact Arithmetic", test_decimal_exact_arithmetic);
+        run_test("Test Decimal Rounding", test_decimal_rounding);
+        run_test("Test Decimal Errors", test_decimal_errors);
+
+        std::cout << "\nModular Tests:" << std::endl;
+        run_test("Test Modint Matches Operators", test_modint_matches_operators);
+        run_test("Test Modint Pow and Inverse", test_modint_pow_and_inverse);
+        run_test("Test Modint Errors", test_modint_errors);
+
+        std::cout << "\nPrimality Tests:" << std::endl;
+        run_test("Test Probable Prime", test_probable_prime);
+        run_test("Test Next Prime and Powmod", test_next_prime_and_powmod);
+
+        std::cout << "\nRandom Generation Tests:" << std::endl;
+        run_test("Test Random Generation Ranges", test_random_generation_ranges);
+        run_test("Test Random Generation Errors", test_random_generation_errors);
+
+        std::cout << "\nCopy-on-Write Tests:" << std::endl;
+        run_test("Test Shared Copy on Write", test_shared_copy_on_write);
+        run_test("Test Shared Self Assignment", test_shared_self_assignment);
+        run_test("Test Shared Concurrent Readers", test_shared_concurrent_readers);
+
+        std::cout << "\nParallel Tests:" << std::endl;
+        run_test("Test Parallel Multiply", test_parallel_multiply);
+        run_test("Test Parallel Conversion", test_parallel_conversion);
+        run_test("Test Parallel Cancellation", test_parallel_cancellation);
+
+        std::cout << "\nAccumulator Tests:" << std::endl;
+        run_test("Test Accumulator Matches Operators", test_accumulator_matches_operators);
+        run_test("Test Accumulator Signs", test_accumulator_signs);
+        run_test("Test Accumulator Repeated Reads", test_accumulator_repeated_reads);
+
+        std::cout << "\nHash Tests:" << std::endl;
+        run_test("Test Hash Equal Values", test_hash_equal_values);
+        run_test("Test Hash Unordered Map", test_hash_unordered_map);
+
+        std::cout << "\nBinary Serialization Tests:" << std::endl;
+        run_test("Test Serialize Buffer Round Trip", test_serialize_buffer_round_trip);
+        run_test("Test Serialize Stream Round Trip", test_serialize_stream_round_trip);
+        run_test("Test Serialize View", test_serialize_view);
+        run_test("Test Serialize Invalid Header", test_serialize_invalid);
+        run_test("Test Serialize Untrusted Limbs", test_serialize_untrusted_limbs);
+        run_test("Test Serialize Untrusted Digits", test_serialize_untrusted_digits);
+        run_test("Test Bytes Import and Export", test_bytes_import_export);
+
+        std::cout << "\nMemory-Mapped File Tests:" << std::endl;
+        run_test("Test Mapped Digit Image as Operand", test_mapped_digit_image_operand);
+        run_test("Test Mapped Limbs Round Trip", test_mapped_limbs_round_trip);
+
         std::cout << "\nRandom Tests:" << std::endl;
         run_test("Test Random with Single Calculation", test_random_single_calculation);
         run_test("Test Random with Different Order", test_random_order);
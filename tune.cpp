@@ -0,0 +1,124 @@
+#include "bigint.hpp"
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <string>
+
+/**
+ * @brief Measures the multiplication tiers of bigint on the local machine and writes the crossover points as a header.
+ * It is a friend of bigint, so it can time each kernel on its own.
+ */
+class bigint_tuner
+{
+private:
+    using kernel = std::vector<std::uint8_t> (*)(std::span<const std::uint8_t>, std::span<const std::uint8_t>, std::size_t);
+
+    /**
+     * @brief Random digits without leading zeros
+     * @param rng Random engine
+     * @param size Number of digits
+     * @return The digits, least significant first
+     */
+    static std::vector<std::uint8_t> random_digits(std::mt19937_64 &rng, std::size_t size)
+    {
+        std::vector<std::uint8_t> digits(size);
+        for (auto &digit : digits)
+            digit = static_cast<std::uint8_t>(rng() % 10);
+        digits.back() = static_cast<std::uint8_t>(1 + rng() % 9);
+        return digits;
+    }
+
+    /**
+     * @brief Best time of a product over several rounds. Each round repeats the product until it takes at least 2 ms.
+     * @param multiply The kernel
+     * @param lhs Digits of the first operand
+     * @param rhs Digits of the second operand
+     * @param threshold Threshold passed to the kernel
+     * @return Seconds per product
+     */
+    static double time_product(kernel multiply, std::span<const std::uint8_t> lhs, std::span<const std::uint8_t> rhs,
+                               std::size_t threshold)
+    {
+        using clock = std::chrono::steady_clock;
+        double best = 1e30;
+        for (int round = 0; round < 5; round++)
+        {
+            std::size_t repeats = 0;
+            const clock::time_point start = clock::now();
+            clock::time_point end = start;
+            do
+            {
+                bigint::scratch_pool::release(multiply(lhs, rhs, threshold));
+                repeats++;
+                end = clock::now();
+            } while (end - start < std::chrono::milliseconds(2));
+            best = std::min(best, std::chrono::duration<double>(end - start).count() / static_cast<double>(repeats));
+        }
+        return best;
+    }
+
+    /**
+     * @brief Schoolbook multiplication with the signature of the dispatcher
+     */
+    static std::vector<std::uint8_t> schoolbook(std::span<const std::uint8_t> lhs, std::span<const std::uint8_t> rhs, std::size_t)
+    {
+        return bigint::multiply_schoolbook(lhs, rhs);
+    }
+
+public:
+    /**
+     * @brief Find the smallest size from which one level of Karatsuba over schoolbook halves beats schoolbook.
+     * The crossover must hold for three sizes in a row, so a single noisy measurement does not decide it.
+     * @return The Karatsuba threshold in digits
+     */
+    static std::size_t karatsuba_threshold()
+    {
+        std::mt19937_64 rng(1);
+        std::size_t wins = 0;
+        std::size_t first_win = 0;
+        for (std::size_t size = 8; size <= 1024; size += std::max<std::size_t>(2, size / 8))
+        {
+            const std::vector<std::uint8_t> lhs = random_digits(rng, size);
+            const std::vector<std::uint8_t> rhs = random_digits(rng, size);
+            // With the threshold at <size>, the top level uses Karatsuba and the halves fall back to schoolbook
+            const double school = time_product(schoolbook, lhs, rhs, 0);
+            const double karatsuba = time_product(bigint::multiply_dispatch, lhs, rhs, size);
+            std::cout << "size " << size << ": schoolbook " << school * 1e6 << " us, karatsuba " << karatsuba * 1e6
+                      << " us" << std::endl;
+
+            if (karatsuba < school)
+            {
+                if (wins++ == 0)
+                    first_win = size;
+                if (wins == 3)
+                    return first_win;
+            }
+            else
+            {
+                wins = 0;
+            }
+        }
+        return BIGINT_KARATSUBA_THRESHOLD;
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    const std::string path = argc > 1 ? argv[1] : "bigint_tuning.hpp";
+    const std::size_t karatsuba = bigint_tuner::karatsuba_threshold();
+
+    std::ofstream file(path, std::ios::trunc);
+    file << "// Generated by tune.cpp for this machine. Run it again after changing the compiler, flags or hardware.\n"
+         << "#ifndef BIGINT_TUNING_HPP\n"
+         << "#define BIGINT_TUNING_HPP\n\n"
+         << "#define BIGINT_KARATSUBA_THRESHOLD " << karatsuba << "\n\n"
+         << "#endif\n";
+    if (!file.flush())
+    {
+        std::cerr << "Error: Cannot write " << path << std::endl;
+        return 1;
+    }
+
+    std::cout << "Karatsuba threshold: " << karatsuba << " digits, written to " << path << std::endl;
+    return 0;
+}